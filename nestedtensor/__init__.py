@@ -2,6 +2,7 @@ import torch
 
 from .nested.creation import as_nested_tensor
 from .nested.creation import nested_tensor
+from .nested.creation import nested_tensor_from_buffer
 
 from .nested.masking import nested_tensor_from_tensor_mask
 from .nested.masking import nested_tensor_from_padded_tensor
@@ -10,6 +11,15 @@ from .nested.nested import NestedTensor
 from .nested.nested import to_nested_tensor
 from .nested.nested import transpose_nchw_nhwc
 from .nested.nested import transpose_nhwc_nchw
+from .nested.nested import add_bias_layer_norm
+from .nested.nested import masked_softmax
+from .nested.nested import linear
+from .nested.nested import conv_bn_relu
+
+from .nested.arena import arena
+
+from .nested.serialization import save
+from .nested.serialization import load
 
 from .nested.fuser import fuse_conv_bn
 from .nested.fuser import fuse_conv_relu
@@ -13,6 +13,11 @@ Tensor NestedTensor_add_Tensor(
     const Tensor& self_,
     const Tensor& other_,
     const Scalar& alpha) {
+  Tensor result = _packed_binary(
+      self_, other_, ::nested_tensor::cpu::AddOp{alpha.to<double>()});
+  if (result.defined()) {
+    return result;
+  }
   Tensor self = self_;
   Tensor other = other_;
   if (is_nested_tensor_impl(self) && is_nested_tensor_impl(other)) {
@@ -118,6 +123,10 @@ Tensor& NestedTensor_add__Tensor(
     Tensor& self_,
     const Tensor& other_,
     const Scalar& alpha) {
+  if (_packed_binary_(
+          self_, other_, ::nested_tensor::cpu::AddOp{alpha.to<double>()})) {
+    return self_;
+  }
   at::Tensor self;
   at::Tensor other;
   std::tie(self, other) = _expand_other_as(self_, other_);
@@ -153,6 +162,11 @@ Tensor& NestedTensor_add_out(
 }
 
 Tensor NestedTensor_div_Tensor(const Tensor& self_, const Tensor& other_) {
+  Tensor result =
+      _packed_binary(self_, other_, ::nested_tensor::cpu::DivOp());
+  if (result.defined()) {
+    return result;
+  }
   Tensor self;
   Tensor other;
   std::tie(self, other) = _expand_other_as(self_, other_);
@@ -161,6 +175,9 @@ Tensor NestedTensor_div_Tensor(const Tensor& self_, const Tensor& other_) {
 }
 
 Tensor& NestedTensor_div__Tensor(Tensor& self_, const Tensor& other_) {
+  if (_packed_binary_(self_, other_, ::nested_tensor::cpu::DivOp())) {
+    return self_;
+  }
   at::Tensor self;
   at::Tensor other;
   std::tie(self, other) = _expand_other_as(self_, other_);
@@ -239,6 +256,11 @@ Tensor& NestedTensor_floor_divide_out(
 }
 
 Tensor NestedTensor_mul_Tensor(const Tensor& self_, const Tensor& other_) {
+  Tensor result =
+      _packed_binary(self_, other_, ::nested_tensor::cpu::MulOp());
+  if (result.defined()) {
+    return result;
+  }
   Tensor self = self_;
   Tensor other = other_;
   if (is_nested_tensor_impl(self) && !is_nested_tensor_impl(other)) {
@@ -300,6 +322,9 @@ Tensor NestedTensor_mul_Tensor(const Tensor& self_, const Tensor& other_) {
 }
 
 Tensor& NestedTensor_mul__Tensor(Tensor& self_, const Tensor& other_) {
+  if (_packed_binary_(self_, other_, ::nested_tensor::cpu::MulOp())) {
+    return self_;
+  }
   at::Tensor self;
   at::Tensor other;
   std::tie(self, other) = _expand_other_as(self_, other_);
@@ -358,6 +383,11 @@ Tensor NestedTensor_sub_Tensor(
     const Tensor& self_,
     const Tensor& other_,
     const Scalar& alpha) {
+  Tensor result = _packed_binary(
+      self_, other_, ::nested_tensor::cpu::SubOp{alpha.to<double>()});
+  if (result.defined()) {
+    return result;
+  }
   Tensor self = self_;
   Tensor other = other_;
   if (is_nested_tensor_impl(self) && !is_nested_tensor_impl(other)) {
@@ -424,6 +454,10 @@ Tensor& NestedTensor_sub__Tensor(
     Tensor& self_,
     const Tensor& other_,
     const Scalar& alpha) {
+  if (_packed_binary_(
+          self_, other_, ::nested_tensor::cpu::SubOp{alpha.to<double>()})) {
+    return self_;
+  }
   at::Tensor self;
   at::Tensor other;
   std::tie(self, other) = _expand_other_as(self_, other_);
@@ -438,6 +472,9 @@ Tensor& NestedTensor_sub__Tensor(
 }
 
 Tensor& NestedTensor_remainder__Tensor(Tensor& self_, const Tensor& other_) {
+  if (_packed_binary_(self_, other_, ::nested_tensor::cpu::RemainderOp())) {
+    return self_;
+  }
   at::Tensor self;
   at::Tensor other;
   std::tie(self, other) = _expand_other_as(self_, other_);
@@ -472,6 +509,9 @@ Tensor& NestedTensor_atan2_out(
 }
 
 Tensor& NestedTensor_atan2_(Tensor& self_, const Tensor& other_) {
+  if (_packed_binary_(self_, other_, ::nested_tensor::cpu::Atan2Op())) {
+    return self_;
+  }
   at::Tensor self;
   at::Tensor other;
   std::tie(self, other) = _expand_other_as(self_, other_);
@@ -486,6 +526,11 @@ Tensor& NestedTensor_atan2_(Tensor& self_, const Tensor& other_) {
 }
 
 Tensor NestedTensor_atan2(const Tensor& self_, const Tensor& other_) {
+  Tensor result =
+      _packed_binary(self_, other_, ::nested_tensor::cpu::Atan2Op());
+  if (result.defined()) {
+    return result;
+  }
   Tensor self;
   Tensor other;
   std::tie(self, other) = _expand_other_as(self_, other_);
@@ -496,6 +541,11 @@ Tensor NestedTensor_atan2(const Tensor& self_, const Tensor& other_) {
 Tensor NestedTensor_remainder_Tensor(
     const Tensor& self_,
     const Tensor& other_) {
+  Tensor result =
+      _packed_binary(self_, other_, ::nested_tensor::cpu::RemainderOp());
+  if (result.defined()) {
+    return result;
+  }
   Tensor self;
   Tensor other;
   std::tie(self, other) = _expand_other_as(self_, other_);
@@ -504,6 +554,9 @@ Tensor NestedTensor_remainder_Tensor(
 }
 
 Tensor& NestedTensor_pow__Tensor(Tensor& self_, const Tensor& other_) {
+  if (_packed_binary_(self_, other_, ::nested_tensor::cpu::PowOp())) {
+    return self_;
+  }
   at::Tensor self;
   at::Tensor other;
   std::tie(self, other) = _expand_other_as(self_, other_);
@@ -526,6 +579,11 @@ Tensor NestedTensor_pow_Scalar(const Scalar& base, const Tensor& exponent_) {
 Tensor NestedTensor_pow_Tensor_Tensor(
     const Tensor& self_,
     const Tensor& other_) {
+  Tensor result =
+      _packed_binary(self_, other_, ::nested_tensor::cpu::PowOp());
+  if (result.defined()) {
+    return result;
+  }
   Tensor self;
   Tensor other;
   std::tie(self, other) = _expand_other_as(self_, other_);
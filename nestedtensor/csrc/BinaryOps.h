@@ -1,7 +1,11 @@
 #include <ATen/core/op_registration/op_registration.h>
+#include <nestedtensor/csrc/cpu/binary.h>
 #include <nestedtensor/csrc/nested_tensor_impl.h>
 #include <nestedtensor/csrc/utils/nested_node_functions.h>
 #include <torch/library.h>
+#include <algorithm>
+#include <numeric>
+#include <vector>
 
 namespace at {
 
@@ -67,4 +71,210 @@ inline std::tuple<at::Tensor, at::Tensor> _expand_other_as(const Tensor& self, c
   return std::make_tuple(self, other);
 }
 
+// Splits the packed buffer of nt into rows for a single pass of a binary op
+// with other, see ::nested_tensor::cpu::broadcast_binary_kernel. other is
+// either a NestedTensor with the same nested size and layout as nt, or a
+// dense Tensor that broadcasts against every constituent of nt without
+// changing its shape. Rows run along the innermost physical dimension of a
+// constituent, which is the channel dimension for channels last layouts.
+// On success other is replaced by the buffer or the contiguous Tensor the
+// rows index into. Returns false if the inputs don't qualify.
+inline bool _plan_broadcast_rows(
+    const Tensor& nt,
+    Tensor& other,
+    std::vector<::nested_tensor::cpu::BroadcastRow>& rows,
+    int64_t& inner_stride) {
+  const int64_t grain_size = at::internal::GRAIN_SIZE;
+  auto push_row = [&rows, &inner_stride, grain_size](
+                      int64_t offset, int64_t other_offset, int64_t length) {
+    // Long rows are split so that they can be spread across threads.
+    for (int64_t start = 0; start < length; start += grain_size) {
+      rows.push_back({offset + start,
+                      other_offset + start * inner_stride,
+                      std::min(grain_size, length - start)});
+    }
+  };
+  auto esize = get_efficient_nested_size(nt);
+  const int64_t numel = esize.numel();
+  if (is_nested_tensor_impl(other)) {
+    if (!get_is_packed(other) ||
+        get_is_contiguous(nt) != get_is_contiguous(other) ||
+        !efficient_size_matches(esize, get_efficient_nested_size(other)) ||
+        !efficient_size_matches(
+            get_efficient_nested_stride(nt),
+            get_efficient_nested_stride(other))) {
+      return false;
+    }
+    other = get_buffer(other);
+    inner_stride = 1;
+    push_row(0, 0, numel);
+    return true;
+  }
+  const int64_t dim = get_dim(nt) - 1;
+  if (dim == 0) {
+    return false;
+  }
+  while (other.dim() > dim && other.size(0) == 1) {
+    other = other.squeeze(0);
+  }
+  if (other.dim() > dim) {
+    return false;
+  }
+  other = other.contiguous();
+  if (other.numel() == 1) {
+    inner_stride = 0;
+    push_row(0, 0, numel);
+    return true;
+  }
+  // Strides of other, broadcast to the dimensions of a constituent.
+  auto opt_sizes = get_opt_sizes(nt);
+  std::vector<int64_t> other_strides(dim, 0);
+  int64_t stride = 1;
+  for (int64_t j = dim - 1; j >= dim - other.dim(); j--) {
+    const int64_t other_size = other.size(j - (dim - other.dim()));
+    if (other_size != 1) {
+      if (!opt_sizes[j + 1] || *opt_sizes[j + 1] != other_size) {
+        return false;
+      }
+      other_strides[j] = stride;
+    }
+    stride *= other_size;
+  }
+  // Order of the dimensions of a constituent in memory.
+  std::vector<int64_t> perm(dim);
+  if (get_is_contiguous(nt)) {
+    std::iota(perm.begin(), perm.end(), 0);
+  } else if (dim == 3) {
+    perm = {1, 2, 0};
+  } else {
+    return false;
+  }
+  inner_stride = other_strides[perm[dim - 1]];
+  const std::vector<int64_t>& offsets = esize.offsets();
+  const at::Tensor& sizes = esize.sizes();
+  const int64_t* sizes_ptr = sizes.data_ptr<int64_t>();
+  std::vector<int64_t> index(dim);
+  for (int64_t i = 0; i < esize.degree(); i++) {
+    const int64_t* size = sizes_ptr + i * dim;
+    const int64_t length = size[perm[dim - 1]];
+    if (offsets[i + 1] == offsets[i]) {
+      continue;
+    }
+    std::fill(index.begin(), index.end(), 0);
+    int64_t other_offset = 0;
+    for (int64_t offset = offsets[i]; offset < offsets[i + 1];
+         offset += length) {
+      push_row(offset, other_offset, length);
+      for (int64_t d = dim - 2; d >= 0; d--) {
+        const int64_t k = perm[d];
+        index[d]++;
+        other_offset += other_strides[k];
+        if (index[d] < size[k]) {
+          break;
+        }
+        other_offset -= other_strides[k] * size[k];
+        index[d] = 0;
+      }
+    }
+  }
+  return true;
+}
+
+// Applies op elementwise to the NestedTensor nt and other in a single pass
+// over the packed buffer of nt. If reversed, op is called with other as its
+// first argument. If inplace, the result is written to the buffer of nt.
+// Only floating point CPU inputs whose promoted type is that of nt are
+// handled. Returns an undefined Tensor if the inputs don't qualify, in which
+// case callers fall back to per-constituent calls.
+template <class F>
+inline Tensor _packed_binary_impl(
+    const Tensor& nt,
+    const Tensor& other_,
+    bool reversed,
+    bool inplace,
+    const F& op) {
+  if (!get_is_packed(nt)) {
+    return Tensor();
+  }
+  Tensor buffer = get_buffer(nt);
+  const Tensor other_values =
+      is_nested_tensor_impl(other_) ? get_buffer(other_) : other_;
+  const ScalarType dtype = buffer.scalar_type();
+  if (!buffer.is_cpu() || !other_values.is_cpu() ||
+      !(dtype == kFloat || dtype == kDouble || dtype == kHalf ||
+        dtype == kBFloat16) ||
+      at::result_type(buffer, other_values) != dtype) {
+    return Tensor();
+  }
+  Tensor other = other_;
+  std::vector<::nested_tensor::cpu::BroadcastRow> rows;
+  int64_t inner_stride = 0;
+  if (!_plan_broadcast_rows(nt, other, rows, inner_stride)) {
+    return Tensor();
+  }
+  other = other.to(dtype);
+  Tensor output;
+  AT_DISPATCH_FLOATING_TYPES_AND2(
+      kHalf, kBFloat16, dtype, "NestedTensor_packed_binary", [&] {
+        using out_t = decltype(op(scalar_t(), scalar_t()));
+        output = inplace ? buffer
+                         : empty_buffer(
+                               buffer.numel(),
+                               buffer.options().dtype(
+                                   c10::CppTypeToScalarType<out_t>::value));
+        const scalar_t* buffer_ptr = buffer.data_ptr<scalar_t>();
+        const scalar_t* other_ptr = other.data_ptr<scalar_t>();
+        out_t* output_ptr = output.data_ptr<out_t>();
+        if (reversed) {
+          ::nested_tensor::cpu::broadcast_binary_kernel(
+              buffer_ptr,
+              other_ptr,
+              output_ptr,
+              rows.data(),
+              rows.size(),
+              buffer.numel(),
+              inner_stride,
+              [&op](scalar_t a, scalar_t b) { return op(b, a); });
+        } else {
+          ::nested_tensor::cpu::broadcast_binary_kernel(
+              buffer_ptr,
+              other_ptr,
+              output_ptr,
+              rows.data(),
+              rows.size(),
+              buffer.numel(),
+              inner_stride,
+              op);
+        }
+      });
+  if (inplace) {
+    return nt;
+  }
+  return wrap_buffer(
+      std::move(output),
+      get_efficient_nested_size(nt),
+      get_efficient_nested_stride(nt));
+}
+
+// Packed path for out of place binary ops, see _packed_binary_impl. Either
+// self or other may be the NestedTensor.
+template <class F>
+inline Tensor _packed_binary(
+    const Tensor& self,
+    const Tensor& other,
+    const F& op) {
+  if (is_nested_tensor_impl(self)) {
+    return _packed_binary_impl(self, other, false, false, op);
+  }
+  return _packed_binary_impl(other, self, true, false, op);
+}
+
+// Packed path for in place binary ops. Returns false if self was not
+// modified.
+template <class F>
+inline bool _packed_binary_(Tensor& self, const Tensor& other, const F& op) {
+  return is_nested_tensor_impl(self) &&
+      _packed_binary_impl(self, other, false, true, op).defined();
+}
+
 } // namespace at
@@ -4,27 +4,37 @@ namespace at {
 
 using namespace torch::nested_tensor;
 
-template <Tensor (*func)(const Tensor&, const Tensor&)>
+template <Tensor (*func)(const Tensor&, const Tensor&), class Op>
 Tensor NestedTensor_binary(const Tensor& self_, const Tensor& other_) {
+  Tensor result = _packed_binary(self_, other_, Op());
+  if (result.defined()) {
+    return result;
+  }
   at::Tensor self;
   at::Tensor other;
   std::tie(self, other) = _expand_other_as(self_, other_);
-  return map_nested_tensor(
+  return parallel_map_nested_tensor(
       [](Tensor s, Tensor o) { return func(s, o); }, self, other);
 }
 
 template <Tensor (*func)(const Tensor&, const Scalar&)>
 Tensor NestedTensor_binary_scalar(const Tensor& self, const Scalar& other) {
-  return map_nested_tensor(
+  if (get_is_packed(self)) {
+    return wrap_buffer(
+        func(get_buffer(self), other),
+        get_efficient_nested_size(self),
+        get_efficient_nested_stride(self));
+  }
+  return parallel_map_nested_tensor(
       [&other](Tensor self) { return func(self, other); }, self);
 }
 
 TORCH_LIBRARY_IMPL(aten, NestedTensor, m) {
-  nt_impl(m, "eq.Tensor", NestedTensor_binary<at::eq>);
+  nt_impl(m, "eq.Tensor", (NestedTensor_binary<at::eq, ::nested_tensor::cpu::EqOp>));
   nt_impl(m, "eq.Scalar", NestedTensor_binary_scalar<at::eq>);
-  nt_impl(m, "ne.Tensor", NestedTensor_binary<at::ne>);
+  nt_impl(m, "ne.Tensor", (NestedTensor_binary<at::ne, ::nested_tensor::cpu::NeOp>));
   nt_impl(m, "ne.Scalar", NestedTensor_binary_scalar<at::ne>);
-  nt_impl(m, "ge.Tensor", NestedTensor_binary<at::ge>);
+  nt_impl(m, "ge.Tensor", (NestedTensor_binary<at::ge, ::nested_tensor::cpu::GeOp>));
   nt_impl(m, "ge.Scalar", NestedTensor_binary_scalar<at::ge>);
 }
 } // namespace at
@@ -1,5 +1,6 @@
 #include <ATen/WrapDimUtilsMulti.h>
 #include <ATen/core/op_registration/op_registration.h>
+#include <nestedtensor/csrc/cpu/reduce.h>
 #include <nestedtensor/csrc/nested_tensor_impl.h>
 #include <torch/library.h>
 #include <algorithm>
@@ -11,6 +12,84 @@ namespace at {
 
 using namespace torch::nested_tensor;
 
+namespace {
+
+// Global reductions of a packed NestedTensor reduce its buffer directly.
+bool _reduce_buffer(const Tensor& self) {
+  return get_is_packed(self) && get_efficient_nested_size(self).degree() > 0;
+}
+
+// Segmented reductions along a single tensor dimension run in one pass over
+// the buffer of a contiguous CPU NestedTensor and write a packed result.
+bool _reduce_segments(const Tensor& self) {
+  if (!get_is_packed(self) || !get_is_contiguous(self) ||
+      get_nested_dim(self) != 1 ||
+      get_efficient_nested_size(self).degree() == 0) {
+    return false;
+  }
+  const Tensor& buffer = get_buffer(self);
+  const ScalarType dtype = buffer.scalar_type();
+  return buffer.is_cpu() &&
+      (dtype == kFloat || dtype == kDouble || dtype == kHalf ||
+       dtype == kBFloat16);
+}
+
+// Views every constituent of self as [outer, size, inner] around tensor
+// dimension dim and returns the nested size of the reduced result.
+EfficientSizeNode _make_segments(
+    const Tensor& self,
+    int64_t dim,
+    bool keepdims,
+    std::vector<::nested_tensor::cpu::ReduceSegment>& segments) {
+  auto esize = get_efficient_nested_size(self);
+  const at::Tensor& sizes = esize.sizes();
+  const int64_t degree = esize.degree();
+  const int64_t tensor_dim = sizes.size(1);
+  const int64_t* sizes_ptr = sizes.data_ptr<int64_t>();
+  const int64_t new_dim = keepdims ? tensor_dim : tensor_dim - 1;
+  at::Tensor new_sizes =
+      empty_buffer(degree * new_dim, at::TensorOptions().dtype(kLong))
+          .view({degree, new_dim});
+  int64_t* new_sizes_ptr = new_sizes.data_ptr<int64_t>();
+  for (int64_t i = 0; i < degree; i++) {
+    for (int64_t j = 0; j < tensor_dim; j++) {
+      if (j != dim) {
+        *new_sizes_ptr++ = sizes_ptr[i * tensor_dim + j];
+      } else if (keepdims) {
+        *new_sizes_ptr++ = 1;
+      }
+    }
+  }
+  segments = ::nested_tensor::cpu::make_reduce_segments(
+      esize.offsets().data(), sizes_ptr, degree, tensor_dim, dim);
+  return EfficientSizeNode(esize.structure(), new_sizes);
+}
+
+// Sums or averages self along tensor dimension dim, see _make_segments.
+Tensor _segmented_sum(
+    const Tensor& self,
+    int64_t dim,
+    bool keepdims,
+    bool mean) {
+  std::vector<::nested_tensor::cpu::ReduceSegment> segments;
+  EfficientSizeNode output_size =
+      _make_segments(self, dim, keepdims, segments);
+  Tensor buffer = get_buffer(self);
+  Tensor output = empty_buffer(output_size.numel(), buffer.options());
+  AT_DISPATCH_FLOATING_TYPES_AND2(
+      kHalf, kBFloat16, buffer.scalar_type(), "NestedTensor_sum_dim", [&] {
+        ::nested_tensor::cpu::segmented_sum_kernel<scalar_t>(
+            buffer.data_ptr<scalar_t>(),
+            output.data_ptr<scalar_t>(),
+            segments.data(),
+            segments.size(),
+            mean);
+      });
+  return wrap_buffer(std::move(output), output_size);
+}
+
+} // namespace
+
 Tensor NestedTensor_cumsum(
     const Tensor& self,
     int64_t dim,
@@ -98,6 +177,14 @@ Tensor NestedTensor_sum_dim(
                    c10::optional<ScalarType> dtype) {
     return at::sum(self, dims, keepdims, dtype);
   };
+  std::vector<int64_t> tensordims;
+  std::vector<int64_t> nesteddims;
+  std::tie(tensordims, nesteddims) = make_split_dims(self, dims);
+  if (tensordims.size() == 1 && nesteddims.size() == 0 &&
+      _reduce_segments(self) &&
+      (!dtype || *dtype == get_buffer(self).scalar_type())) {
+    return _segmented_sum(self, tensordims[0], keepdims, false);
+  }
   return NestedTensor_func_dim<decltype(my_sum)>(
       my_sum, self, dims, keepdims, dtype);
 }
@@ -107,7 +194,37 @@ std::tuple<Tensor, Tensor> NestedTensor_max_dim(
     int64_t dim,
     bool keepdims) {
   int64_t nested_dim = get_nested_tensor_impl(self)->nested_dim();
+  dim = maybe_wrap_dim(dim, get_dim(self));
   at::Tensor output = self;
+  if (dim >= nested_dim && _reduce_segments(self)) {
+    std::vector<::nested_tensor::cpu::ReduceSegment> segments;
+    EfficientSizeNode output_size =
+        _make_segments(self, dim - nested_dim, keepdims, segments);
+    bool nonempty = std::all_of(
+        segments.begin(),
+        segments.end(),
+        [](const ::nested_tensor::cpu::ReduceSegment& segment) {
+          return segment.size > 0;
+        });
+    if (nonempty) {
+      Tensor buffer = get_buffer(self);
+      Tensor values = empty_buffer(output_size.numel(), buffer.options());
+      Tensor indices =
+          empty_buffer(output_size.numel(), buffer.options().dtype(kLong));
+      AT_DISPATCH_FLOATING_TYPES_AND2(
+          kHalf, kBFloat16, buffer.scalar_type(), "NestedTensor_max_dim", [&] {
+            ::nested_tensor::cpu::segmented_max_kernel<scalar_t>(
+                buffer.data_ptr<scalar_t>(),
+                values.data_ptr<scalar_t>(),
+                indices.data_ptr<int64_t>(),
+                segments.data(),
+                segments.size());
+          });
+      return std::make_tuple(
+          wrap_buffer(std::move(values), output_size),
+          wrap_buffer(std::move(indices), output_size));
+    }
+  }
   if (dim >= nested_dim) {
     std::vector<TensorNode> result = unzip(map(
         [nested_dim, dim, keepdims](at::Tensor tensor) {
@@ -136,6 +253,9 @@ std::tuple<Tensor, Tensor> NestedTensor_max_dim(
 }
 
 Tensor NestedTensor_max(const Tensor& self) {
+  if (_reduce_buffer(self)) {
+    return at::max(get_buffer(self));
+  }
   auto tensors = flatten_nested_tensor(map_nested_tensor(
       [](at::Tensor tensor) { return at::max(tensor); }, self));
   if (tensors.size() == 0) {
@@ -156,11 +276,22 @@ Tensor NestedTensor_mean_dim(
                     c10::optional<ScalarType> dtype) {
     return at::mean(self, dims, keepdims, dtype);
   };
+  std::vector<int64_t> tensordims;
+  std::vector<int64_t> nesteddims;
+  std::tie(tensordims, nesteddims) = make_split_dims(self, dims);
+  if (tensordims.size() == 1 && nesteddims.size() == 0 &&
+      _reduce_segments(self) &&
+      (!dtype || *dtype == get_buffer(self).scalar_type())) {
+    return _segmented_sum(self, tensordims[0], keepdims, true);
+  }
   return NestedTensor_func_dim<decltype(my_mean)>(
       my_mean, self, dims, keepdims, dtype);
 }
 
 Tensor NestedTensor_sum(const Tensor& self, c10::optional<ScalarType> dtype) {
+  if (_reduce_buffer(self)) {
+    return at::sum(get_buffer(self), dtype);
+  }
   auto tensors = flatten_nested_tensor(map_nested_tensor(
       [&dtype](at::Tensor tensor) { return at::sum(tensor, dtype); }, self));
   if (tensors.size() == 0) {
@@ -230,6 +361,9 @@ std::tuple<Tensor, Tensor, Tensor> _merge_m2(
 }
 
 Tensor NestedTensor_var(const Tensor& self, bool unbiased) {
+  if (_reduce_buffer(self)) {
+    return at::var(get_buffer(self), unbiased);
+  }
   at::Tensor m2_tensor, mean_tensor, numel;
   std::vector<at::Tensor> tensors = flatten(get_nested_tensor_structure(self));
   if (tensors.size() == 0) {
@@ -258,6 +392,24 @@ Tensor NestedTensor_var_dim(
   std::vector<int64_t> tensordims;
   std::vector<int64_t> nesteddims;
   std::tie(tensordims, nesteddims) = make_split_dims(self, dims);
+  if (nesteddims.size() == 0 && tensordims.size() == 1 &&
+      _reduce_segments(self)) {
+    std::vector<::nested_tensor::cpu::ReduceSegment> segments;
+    EfficientSizeNode output_size =
+        _make_segments(self, tensordims[0], keepdims, segments);
+    Tensor buffer = get_buffer(self);
+    Tensor output = empty_buffer(output_size.numel(), buffer.options());
+    AT_DISPATCH_FLOATING_TYPES_AND2(
+        kHalf, kBFloat16, buffer.scalar_type(), "NestedTensor_var_dim", [&] {
+          ::nested_tensor::cpu::segmented_var_kernel<scalar_t>(
+              buffer.data_ptr<scalar_t>(),
+              output.data_ptr<scalar_t>(),
+              segments.data(),
+              segments.size(),
+              unbiased);
+        });
+    return wrap_buffer(std::move(output), output_size);
+  }
 
   auto nested_size = get_nested_size(self);
   int64_t nested_dim = get_nested_tensor_impl(self)->nested_dim();
@@ -317,6 +469,9 @@ Tensor NestedTensor_var_dim(
 }
 
 Tensor NestedTensor_prod(const Tensor& self, c10::optional<ScalarType> dtype) {
+  if (_reduce_buffer(self)) {
+    return at::prod(get_buffer(self), dtype);
+  }
   auto tensors = flatten_nested_tensor(map_nested_tensor(
       [&dtype](at::Tensor tensor) { return at::prod(tensor, dtype); }, self));
   if (tensors.size() == 0) {
@@ -1,4 +1,5 @@
 #include <ATen/ATen.h>
+#include <nestedtensor/csrc/cpu/softmax.h>
 #include <nestedtensor/csrc/nested_tensor_impl.h>
 #include <nestedtensor/csrc/utils/nested_node_functions.h>
 #include <torch/extension.h>
@@ -9,6 +10,73 @@ namespace F = torch::nn::functional;
 
 namespace at {
 
+using namespace torch::nested_tensor;
+
+namespace {
+
+// Computes softmax(scale * input + mask), or its log, along tensor dimension
+// dim of a contiguous CPU NestedTensor in a single pass over its buffer. dim
+// may be the ragged dimension. mask must be a NestedTensor of the same nested
+// size and dtype. Returns an undefined Tensor if the inputs don't qualify, in
+// which case callers fall back to per-constituent calls.
+Tensor _segmented_softmax(
+    const Tensor& input,
+    int64_t dim,
+    const c10::optional<Tensor>& mask,
+    double scale,
+    bool log,
+    c10::optional<ScalarType> dtype) {
+  if (!get_is_packed(input) || !get_is_contiguous(input) ||
+      get_nested_dim(input) != 1) {
+    return Tensor();
+  }
+  auto esize = get_efficient_nested_size(input);
+  Tensor buffer = get_buffer(input);
+  const ScalarType buffer_dtype = dtype ? *dtype : buffer.scalar_type();
+  if (esize.degree() == 0 || !buffer.is_cpu() ||
+      !(buffer_dtype == kFloat || buffer_dtype == kDouble ||
+        buffer_dtype == kHalf || buffer_dtype == kBFloat16)) {
+    return Tensor();
+  }
+  Tensor mask_buffer;
+  if (mask) {
+    if (!is_nested_tensor_impl(*mask) || !get_is_packed(*mask) ||
+        !get_is_contiguous(*mask) ||
+        !efficient_size_matches(esize, get_efficient_nested_size(*mask))) {
+      return Tensor();
+    }
+    mask_buffer = get_buffer(*mask);
+    if (!mask_buffer.is_cpu() || mask_buffer.scalar_type() != buffer_dtype) {
+      return Tensor();
+    }
+  }
+  buffer = buffer.to(buffer_dtype);
+  const at::Tensor& sizes = esize.sizes();
+  std::vector<::nested_tensor::cpu::ReduceSegment> segments =
+      ::nested_tensor::cpu::make_reduce_segments(
+          esize.offsets().data(),
+          sizes.data_ptr<int64_t>(),
+          esize.degree(),
+          sizes.size(1),
+          dim);
+  Tensor output = empty_buffer(buffer.numel(), buffer.options());
+  AT_DISPATCH_FLOATING_TYPES_AND2(
+      kHalf, kBFloat16, buffer_dtype, "NestedTensor_softmax", [&] {
+        ::nested_tensor::cpu::segmented_softmax_kernel<scalar_t>(
+            buffer.data_ptr<scalar_t>(),
+            mask_buffer.defined() ? mask_buffer.data_ptr<scalar_t>() : nullptr,
+            output.data_ptr<scalar_t>(),
+            segments.data(),
+            segments.size(),
+            scale,
+            log);
+      });
+  return wrap_buffer(
+      std::move(output), esize, get_efficient_nested_stride(input));
+}
+
+} // namespace
+
 Tensor NestedTensor_softmax(
     const Tensor& input,
     const int64_t dim_,
@@ -20,6 +88,11 @@ Tensor NestedTensor_softmax(
       dim >= nested_dim,
       "Cannot apply softmax across nested dimensions ",
       std::to_string(dim));
+  Tensor result = _segmented_softmax(
+      input, dim - nested_dim, c10::nullopt, 1.0, false, dtype);
+  if (result.defined()) {
+    return result;
+  }
   return map_nested_tensor(
       [dim, nested_dim, dtype](const at::Tensor t) {
         return at::softmax(t, dim - nested_dim, dtype);
@@ -38,6 +111,11 @@ Tensor NestedTensor_log_softmax(
       dim >= nested_dim,
       "Cannot apply log_softmax across nested dimensions ",
       std::to_string(dim));
+  Tensor result = _segmented_softmax(
+      input, dim - nested_dim, c10::nullopt, 1.0, true, dtype);
+  if (result.defined()) {
+    return result;
+  }
   return map_nested_tensor(
       [dim, nested_dim, dtype](const at::Tensor t) {
         return at::log_softmax(t, dim - nested_dim, dtype);
@@ -45,9 +123,74 @@ Tensor NestedTensor_log_softmax(
       input);
 }
 
+// dim_ is passed through to the constituents unchanged, i.e. it is a
+// dimension of a constituent rather than of the NestedTensor.
+Tensor NestedTensor__log_softmax(
+    const Tensor& self,
+    const int64_t dim_,
+    const bool half_to_float) {
+  c10::optional<ScalarType> dtype;
+  if (half_to_float && get_buffer(self).scalar_type() == kHalf) {
+    dtype = kFloat;
+  }
+  if (get_dim(self) > 1) {
+    Tensor result = _segmented_softmax(
+        self,
+        maybe_wrap_dim(dim_, get_dim(self) - 1),
+        c10::nullopt,
+        1.0,
+        true,
+        dtype);
+    if (result.defined()) {
+      return result;
+    }
+  }
+  return map_nested_tensor(
+      [&](Tensor a) { return at::_log_softmax(a, dim_, half_to_float); }, self);
+}
+
+// Computes softmax(scale * input + mask) along dim, fusing the scaling and
+// masking of attention scores into the softmax.
+Tensor NestedTensor_masked_softmax(
+    const Tensor& input,
+    int64_t dim_,
+    const c10::optional<Tensor>& mask,
+    double scale) {
+  int64_t dim = maybe_wrap_dim(dim_, get_dim(input));
+  int64_t nested_dim = get_nested_dim(input);
+  TORCH_CHECK(
+      dim >= nested_dim,
+      "Cannot apply softmax across nested dimensions ",
+      std::to_string(dim));
+  Tensor result = _segmented_softmax(
+      input, dim - nested_dim, mask, scale, false, c10::nullopt);
+  if (result.defined()) {
+    return result;
+  }
+  Tensor values = input;
+  if (scale != 1.0) {
+    values = at::mul(
+        values, at::scalar_tensor(scale, get_buffer(input).options()));
+  }
+  if (mask) {
+    values = at::add(values, *mask);
+  }
+  return at::softmax(values, dim);
+}
+
 TORCH_LIBRARY_IMPL(aten, NestedTensor, m) {
   nt_impl(m, "softmax.int", NestedTensor_softmax);
   nt_impl(m, "log_softmax.int", NestedTensor_log_softmax);
+  nt_impl(m, "_log_softmax", NestedTensor__log_softmax);
+}
+
+TORCH_LIBRARY_FRAGMENT(nestedtensor, m) {
+  m.def(
+      "masked_softmax(Tensor input, int dim, Tensor? mask=None, float scale=1.0) -> Tensor");
+  m.impl(
+      "masked_softmax",
+      NestedTensorKey,
+      TORCH_FN(NestedTensor_masked_softmax));
 }
 
 } // namespace at
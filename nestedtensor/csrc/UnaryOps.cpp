@@ -6,50 +6,96 @@ namespace at {
 
 using namespace torch::nested_tensor;
 
+namespace {
+
+// Elementwise ops on a packed NestedTensor are applied to its buffer in a
+// single call, reusing the nested size and stride. Everything else falls
+// back to one call per constituent.
+template <class F>
+Tensor _unary_map(const Tensor& self, F&& fn) {
+  if (get_is_packed(self)) {
+    return wrap_buffer(
+        fn(get_buffer(self)),
+        get_efficient_nested_size(self),
+        get_efficient_nested_stride(self));
+  }
+  return parallel_map_nested_tensor(std::forward<F>(fn), self);
+}
+
+template <class F>
+Tensor& _unary_apply(Tensor& self, F&& fn) {
+  if (get_is_packed(self)) {
+    Tensor buffer = get_buffer(self);
+    fn(buffer);
+    return self;
+  }
+  parallel_apply_nested_tensor(std::forward<F>(fn), self);
+  return self;
+}
+
+// fn is called as fn(result, self). The buffers are only used directly if
+// both tensors are packed with the same layout.
+template <class F>
+Tensor& _unary_out(const Tensor& self, Tensor& result, F&& fn) {
+  if (is_nested_tensor_impl(result) && get_is_packed(self) &&
+      get_is_packed(result) &&
+      efficient_size_matches(
+          get_efficient_nested_size(self),
+          get_efficient_nested_size(result)) &&
+      efficient_size_matches(
+          get_efficient_nested_stride(self),
+          get_efficient_nested_stride(result))) {
+    Tensor result_buffer = get_buffer(result);
+    fn(result_buffer, get_buffer(self));
+    return result;
+  }
+  parallel_apply_nested_tensor(
+      [&fn](Tensor& result, Tensor& self) { fn(result, self); }, result, self);
+  return result;
+}
+
+} // namespace
+
 // NOTE: Can't reuse dispatch from cos_ to cos_out either, because it requries
 // support for at::empty through unary_op_impl
 template <class F, F func>
 Tensor& NestedTensor_unary_(Tensor& self) {
-  apply_nested_tensor([](at::Tensor& tensor) { func(tensor); }, self);
-  return self;
+  return _unary_apply(self, [](at::Tensor& tensor) { func(tensor); });
 }
 
 // NOTE: Missing at::sign_ etc. -> very annoying. not clear why.
 template <class F, F func>
 Tensor& NestedTensor_unary_method_(Tensor& self) {
-  apply_nested_tensor([](at::Tensor& tensor) { (tensor.*func)(); }, self);
-  return self;
+  return _unary_apply(self, [](at::Tensor& tensor) { (tensor.*func)(); });
 }
 
 template <class F, F func>
 Tensor NestedTensor_unary(const Tensor& self) {
-  return map_nested_tensor(
-      [](at::Tensor tensor) { return func(tensor); }, self);
+  return _unary_map(self, [](at::Tensor tensor) { return func(tensor); });
 }
 
 template <class F, F func>
 Tensor& NestedTensor_unary_out(const Tensor& self, Tensor& result) {
-  apply_nested_tensor(
-      [](Tensor& result, Tensor& self) { func(result, self); }, result, self);
-  return result;
+  return _unary_out(self, result, [](Tensor& result, const Tensor& self) {
+    func(result, self);
+  });
 }
 
 Tensor& NestedTensor_clamp_(
     Tensor& self,
     const optional<c10::Scalar>& min,
     const optional<c10::Scalar>& max) {
-  apply_nested_tensor(
-      [min, max](at::Tensor& tensor) { at::clamp_(tensor, min, max); }, self);
-  return self;
+  return _unary_apply(
+      self, [min, max](at::Tensor& tensor) { at::clamp_(tensor, min, max); });
 }
 
 Tensor NestedTensor_clamp(
     const Tensor& self,
     const optional<c10::Scalar>& min,
     const optional<c10::Scalar>& max) {
-  return map_nested_tensor(
-      [min, max](at::Tensor tensor) { return at::clamp(tensor, min, max); },
-      self);
+  return _unary_map(self, [min, max](at::Tensor tensor) {
+    return at::clamp(tensor, min, max);
+  });
 }
 
 Tensor& NestedTensor_clamp_out(
@@ -57,71 +103,57 @@ Tensor& NestedTensor_clamp_out(
     const optional<Scalar>& min,
     const optional<Scalar>& max,
     Tensor& result) {
-  apply_nested_tensor(
-      [min, max](const at::Tensor self, at::Tensor result) {
+  return _unary_out(
+      self, result, [min, max](Tensor& result, const Tensor& self) {
         at::clamp_out(result, self, min, max);
-      },
-      self,
-      result);
-  return result;
+      });
 }
 
 Tensor& NestedTensor_clamp_min_(Tensor& self, const c10::Scalar& min) {
-  apply_nested_tensor(
-      [min](at::Tensor& tensor) { at::clamp_min_(tensor, min); }, self);
-  return self;
+  return _unary_apply(
+      self, [min](at::Tensor& tensor) { at::clamp_min_(tensor, min); });
 }
 
 Tensor NestedTensor_clamp_min(const Tensor& self, const c10::Scalar& min) {
-  return map_nested_tensor(
-      [min](at::Tensor tensor) { return at::clamp_min(tensor, min); }, self);
+  return _unary_map(
+      self, [min](at::Tensor tensor) { return at::clamp_min(tensor, min); });
 }
 
 Tensor& NestedTensor_clamp_min_out(
     const Tensor& self,
     const c10::Scalar& min,
     Tensor& result) {
-  apply_nested_tensor(
-      [min](at::Tensor result, const at::Tensor tensor) {
-        at::clamp_min_out(result, tensor, min);
-      },
-      result,
-      self);
-  return result;
+  return _unary_out(self, result, [min](Tensor& result, const Tensor& self) {
+    at::clamp_min_out(result, self, min);
+  });
 }
 
 Tensor& NestedTensor_clamp_max_(Tensor& self, const c10::Scalar& min) {
-  apply_nested_tensor(
-      [min](at::Tensor tensor) { at::clamp_max_(tensor, min); }, self);
-  return self;
+  return _unary_apply(
+      self, [min](at::Tensor& tensor) { at::clamp_max_(tensor, min); });
 }
 
 Tensor NestedTensor_clamp_max(const Tensor& self, const c10::Scalar& min) {
-  return map_nested_tensor(
-      [min](at::Tensor tensor) { return at::clamp_max(tensor, min); }, self);
+  return _unary_map(
+      self, [min](at::Tensor tensor) { return at::clamp_max(tensor, min); });
 }
 
 Tensor& NestedTensor_clamp_max_out(
     const Tensor& self,
     const Scalar& max,
     Tensor& result) {
-  apply_nested_tensor(
-      [max](Tensor result, const Tensor tensor) {
-        at::clamp_max_out(result, tensor, max);
-      },
-      result,
-      self);
-  return result;
+  return _unary_out(self, result, [max](Tensor& result, const Tensor& self) {
+    at::clamp_max_out(result, self, max);
+  });
 }
 
 Tensor& NestedTensor_mvlgamma_(Tensor& self, int64_t p) {
-  apply_nested_tensor([p](at::Tensor tensor) { tensor.mvlgamma_(p); }, self);
-  return self;
+  return _unary_apply(self, [p](at::Tensor& tensor) { tensor.mvlgamma_(p); });
 }
 
 Tensor NestedTensor_mvlgamma(const Tensor& self, int64_t p) {
-  return map_nested_tensor(
-      [p](at::Tensor tensor) { return at::mvlgamma(tensor, p); }, self);
+  return _unary_map(
+      self, [p](at::Tensor tensor) { return at::mvlgamma(tensor, p); });
 }
 
 #define UNARY_OP_INPLACE_METHOD(NAME)                                     \
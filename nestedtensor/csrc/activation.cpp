@@ -19,6 +19,17 @@ Tensor NestedTensor_gelu(const Tensor& self) {
       [](at::Tensor tensor) { return at::gelu(tensor); }, self);
 }
 
+Tensor NestedTensor_silu(const Tensor& self) {
+  if (is_nested_tensor_impl(self) && get_is_contiguous(self)) {
+    return wrap_buffer(
+        at::silu(get_buffer(self)),
+        get_efficient_nested_size(self),
+        get_efficient_nested_stride(self));
+  }
+  return map_nested_tensor(
+      [](at::Tensor tensor) { return at::silu(tensor); }, self);
+}
+
 Tensor NestedTensor_elu(const Tensor& self, const Scalar& alpha, const Scalar& scale, const Scalar& input_scale) {
   if (is_nested_tensor_impl(self) && get_is_contiguous(self)) {
     return wrap_buffer(
@@ -62,6 +73,7 @@ Tensor& NestedTensor_relu_(Tensor& self) {
 
 TORCH_LIBRARY_IMPL(aten, NestedTensor, m) {
   nt_impl(m, "gelu", NestedTensor_gelu);
+  nt_impl(m, "silu", NestedTensor_silu);
   nt_impl(m, "elu", NestedTensor_elu);
 }
 
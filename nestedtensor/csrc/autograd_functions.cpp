@@ -1,3 +1,5 @@
+#include <nestedtensor/csrc/cpu/batchnorm.h>
+#include <nestedtensor/csrc/cpu/interpolate.h>
 #include <nestedtensor/csrc/nested_tensor_impl.h>
 #include <nestedtensor/csrc/utils/nested_node_functions.h>
 #include <torch/extension.h>
@@ -21,12 +23,91 @@ Tensor NestedTensor_dropout(const Tensor& input, double p, bool train) {
   return input;
 }
 
+Tensor NestedTensor_upsample2d_cpu(
+    const Tensor& input,
+    const std::vector<int64_t>& output_sizes,
+    c10::optional<double> scales_h,
+    c10::optional<double> scales_w,
+    bool bilinear,
+    bool align_corners) {
+  if (!is_nested_tensor_impl(input) || get_nested_dim(input) != 1 ||
+      get_dim(input) != 4 || !get_is_contiguous(input)) {
+    return Tensor();
+  }
+  Tensor buffer = get_buffer(input);
+  const ScalarType dtype = buffer.scalar_type();
+  auto opt_sizes = get_opt_sizes(input);
+  EfficientSizeNode nested_size = get_efficient_nested_size(input);
+  const int64_t degree = nested_size.degree();
+  if (!buffer.is_cpu() || !opt_sizes[1] || degree == 0 ||
+      !(dtype == kFloat || dtype == kDouble || dtype == kBFloat16)) {
+    return Tensor();
+  }
+  const bool per_image = (int64_t)(output_sizes.size()) == 2 * degree;
+  if (output_sizes.size() != 2 && !per_image &&
+      !(output_sizes.empty() && scales_h && scales_w)) {
+    return Tensor();
+  }
+  const int64_t channels = *opt_sizes[1];
+  const int64_t* sizes_ptr = nested_size.sizes().data_ptr<int64_t>();
+  const std::vector<int64_t>& offsets = nested_size.offsets();
+  std::vector<::nested_tensor::cpu::ResizeImage> images(degree);
+  int64_t output_numel = 0;
+  for (int64_t i = 0; i < degree; i++) {
+    ::nested_tensor::cpu::ResizeImage& image = images[i];
+    image.input_offset = offsets[i];
+    image.height = sizes_ptr[i * 3 + 1];
+    image.width = sizes_ptr[i * 3 + 2];
+    if (output_sizes.empty()) {
+      image.output_height = (int64_t)(std::floor(image.height * *scales_h));
+      image.output_width = (int64_t)(std::floor(image.width * *scales_w));
+    } else {
+      image.output_height = output_sizes[per_image ? 2 * i : 0];
+      image.output_width = output_sizes[per_image ? 2 * i + 1 : 1];
+    }
+    if (image.height <= 0 || image.width <= 0 || image.output_height <= 0 ||
+        image.output_width <= 0) {
+      return Tensor();
+    }
+    image.output_offset = output_numel;
+    output_numel += channels * image.output_height * image.output_width;
+  }
+  int64_t i = 0;
+  EfficientSizeNode result_size = map_efficient_size(
+      [&images, &i](int64_t* size_ptr, int64_t size) {
+        size_ptr[1] = images[i].output_height;
+        size_ptr[2] = images[i].output_width;
+        i++;
+      },
+      nested_size);
+  Tensor output = empty_buffer(output_numel, buffer.options());
+  AT_DISPATCH_FLOATING_TYPES_AND(
+      kBFloat16, dtype, "NestedTensor_upsample2d_cpu", [&] {
+        ::nested_tensor::cpu::upsample2d_kernel<scalar_t>(
+            buffer.data_ptr<scalar_t>(),
+            output.data_ptr<scalar_t>(),
+            images.data(),
+            degree,
+            channels,
+            scales_h.value_or(0),
+            scales_w.value_or(0),
+            bilinear,
+            align_corners);
+      });
+  return wrap_buffer(std::move(output), result_size);
+}
+
 Tensor NestedTensor_upsample_bilinear2d(
     const Tensor& input,
     IntArrayRef output_size,
     bool align_corners,
     c10::optional<double> scales_h,
     c10::optional<double> scales_w) {
+  Tensor result = NestedTensor_upsample2d_cpu(
+      input, output_size.vec(), scales_h, scales_w, true, align_corners);
+  if (result.defined()) {
+    return result;
+  }
   return map_nested_tensor(
       [&](at::Tensor t) {
         return at::upsample_bilinear2d(
@@ -82,6 +163,83 @@ std::vector<int64_t> make_scalar_shape(int64_t input_dim, int64_t n_input) {
   return result;
 }
 
+namespace {
+
+// Applies inference mode batch norm to a contiguous or channels last CPU
+// NestedTensor in a single pass over its buffer. The statistics and the
+// affine parameters are folded into a per-channel scale and shift first.
+// Returns an undefined Tensor if the inputs aren't supported.
+Tensor _batch_norm_cpu(
+    const Tensor& input,
+    const c10::optional<Tensor>& weight,
+    const c10::optional<Tensor>& bias,
+    const Tensor& mean,
+    const Tensor& var,
+    double eps,
+    int64_t n_input) {
+  Tensor buffer = get_buffer(input);
+  const ScalarType dtype = buffer.scalar_type();
+  auto usable = [](const c10::optional<Tensor>& t) {
+    return !t || (!is_nested_tensor_impl(*t) && t->is_cpu());
+  };
+  if (!buffer.is_cpu() || get_nested_dim(input) != 1 || n_input == 0 ||
+      !(dtype == kFloat || dtype == kDouble || dtype == kBFloat16) ||
+      !usable(mean) || !usable(var) || !usable(weight) || !usable(bias) ||
+      mean.numel() != n_input || var.numel() != n_input) {
+    return Tensor();
+  }
+  const bool contiguous = get_is_contiguous(input);
+  const bool channels_last = !contiguous && get_dim(input) == 4 &&
+      get_is_contiguous(input, c10::MemoryFormat::ChannelsLast);
+  EfficientSizeNode nested_size = get_efficient_nested_size(input);
+  const int64_t degree = nested_size.degree();
+  if ((!contiguous && !channels_last) || degree == 0) {
+    return Tensor();
+  }
+  const ScalarType acc_dtype = dtype == kDouble ? kDouble : kFloat;
+  Tensor scale = at::rsqrt(var.to(acc_dtype) + eps);
+  if (weight) {
+    scale = scale * weight->to(acc_dtype);
+  }
+  Tensor shift = -mean.to(acc_dtype) * scale;
+  if (bias) {
+    shift = shift + bias->to(acc_dtype);
+  }
+  scale = scale.contiguous();
+  shift = shift.contiguous();
+  std::vector<int64_t> plane_offsets;
+  if (contiguous) {
+    const std::vector<int64_t>& offsets = nested_size.offsets();
+    plane_offsets.reserve(degree * n_input + 1);
+    for (int64_t i = 0; i < degree; i++) {
+      const int64_t plane = nested_size.numel(i) / n_input;
+      for (int64_t c = 0; c < n_input; c++) {
+        plane_offsets.push_back(offsets[i] + c * plane);
+      }
+    }
+    plane_offsets.push_back(offsets[degree]);
+  }
+  const int64_t numel = nested_size.numel();
+  Tensor output = empty_buffer(numel, buffer.options());
+  AT_DISPATCH_FLOATING_TYPES_AND(
+      kBFloat16, dtype, "NestedTensor_batch_norm_cpu", [&] {
+        using acc_t = at::opmath_type<scalar_t>;
+        ::nested_tensor::cpu::channel_affine_kernel<scalar_t>(
+            buffer.data_ptr<scalar_t>(),
+            output.data_ptr<scalar_t>(),
+            scale.data_ptr<acc_t>(),
+            shift.data_ptr<acc_t>(),
+            n_input,
+            contiguous ? plane_offsets.data() : nullptr,
+            contiguous ? degree * n_input : 0,
+            numel);
+      });
+  return wrap_buffer(
+      std::move(output), nested_size, get_efficient_nested_stride(input));
+}
+
+} // namespace
+
 Tensor NestedTensor_batch_norm(
     const Tensor& input,
     const c10::optional<Tensor>& weight /* optional */,
@@ -200,6 +358,11 @@ Tensor NestedTensor_batch_norm(
     return wrap_buffer(std::move(input_buffer), get_efficient_nested_size(output), get_efficient_nested_stride(output));
   }
 #endif
+  Tensor result =
+      _batch_norm_cpu(input, weight, bias, mean, var, eps, n_input);
+  if (result.defined()) {
+    return result;
+  }
   auto scalar_shape = make_scalar_shape(get_dim(input), n_input);
 
   at::Tensor invstd = 1 / at::sqrt(*running_var + eps);
@@ -218,7 +381,7 @@ Tensor NestedTensor_batch_norm(
 }
 
 TORCH_LIBRARY_IMPL(aten, NestedTensor, m) {
-  // nt_impl(m, "upsample_bilinear2d", NestedTensor_upsample_bilinear2d);
+  nt_impl(m, "upsample_bilinear2d", NestedTensor_upsample_bilinear2d);
   nt_impl(m, "clone", NestedTensor_clone);
   nt_impl(m, "dropout", NestedTensor_dropout);
   nt_impl(m, "batch_norm", NestedTensor_batch_norm);
@@ -1,3 +1,6 @@
+#include <nestedtensor/csrc/cpu/conv.h>
+#include <nestedtensor/csrc/cpu/linear.h>
+#include <nestedtensor/csrc/cpu/parallel.h>
 #include <nestedtensor/csrc/nested_tensor_impl.h>
 #include <nestedtensor/csrc/utils/nested_node_functions.h>
 #include <torch/extension.h>
@@ -10,12 +13,195 @@
 #endif
 #include <nestedtensor/csrc/masking.h>
 #include <nestedtensor/csrc/transpose.h>
+#include <algorithm>
 
 using namespace torch::nn;
 namespace F = torch::nn::functional;
 
 namespace at {
 
+namespace {
+
+// Convolution engine for ragged batches of images on CPU. The output pixels
+// of all images form the rows of a single packed [rows, out_channels]
+// matrix, which is the channels last layout of the result. The rows are
+// split into tiles that are processed in parallel. For each tile the im2col
+// columns of its pixels are gathered into a per-thread buffer and multiplied
+// with the weight in one GEMM per group, after which the bias and
+// activation are applied while the tile is still in cache. Tiling bounds the
+// size of the column buffer, which would otherwise be
+// kernel_h * kernel_w times larger than the input. A 1x1 convolution of a
+// channels last input uses the input buffer as its columns, so it is a
+// single matmul. The result has the memory format of the input. Returns an
+// undefined Tensor if the inputs aren't supported.
+Tensor _conv2d_cpu(
+    const Tensor& input,
+    const Tensor& weight,
+    const c10::optional<Tensor>& bias,
+    IntArrayRef stride,
+    IntArrayRef padding,
+    IntArrayRef dilation,
+    int64_t groups,
+    ::nested_tensor::cpu::Activation activation) {
+  if (!is_nested_tensor_impl(input) || is_nested_tensor_impl(weight) ||
+      get_nested_dim(input) != 1 || weight.dim() != 4 || stride.size() != 2 ||
+      padding.size() != 2 || dilation.size() != 2 || groups < 1) {
+    return Tensor();
+  }
+  Tensor buffer = get_buffer(input);
+  const ScalarType dtype = buffer.scalar_type();
+  if (!buffer.is_cpu() || !weight.is_cpu() || weight.scalar_type() != dtype ||
+      !(dtype == kFloat || dtype == kDouble || dtype == kBFloat16)) {
+    return Tensor();
+  }
+  const int64_t out_channels = weight.size(0);
+  const int64_t group_channels = weight.size(1);
+  const int64_t channels = group_channels * groups;
+  auto opt_sizes = get_opt_sizes(input);
+  // Depthwise convolutions are left to ATen's specialized kernels.
+  if (!opt_sizes[1] || *opt_sizes[1] != channels ||
+      out_channels % groups != 0 || (groups > 1 && group_channels == 1)) {
+    return Tensor();
+  }
+  if (bias &&
+      (is_nested_tensor_impl(*bias) || !bias->is_cpu() ||
+       bias->scalar_type() != dtype || bias->numel() != out_channels)) {
+    return Tensor();
+  }
+  auto impl = get_nested_tensor_impl(input);
+  const int64_t degree = impl->get_nested_size().degree();
+  if (degree == 0) {
+    return Tensor();
+  }
+  const ::nested_tensor::cpu::ConvParams params{
+      weight.size(2),
+      weight.size(3),
+      stride[0],
+      stride[1],
+      padding[0],
+      padding[1],
+      dilation[0],
+      dilation[1]};
+  std::vector<::nested_tensor::cpu::ConvImage> images(degree);
+  std::vector<int64_t> row_offsets(degree + 1, 0);
+  Tensor result_sizes = torch::empty({degree, 3}, torch::kInt64);
+  Tensor result_strides = torch::empty({degree, 3}, torch::kInt64);
+  int64_t* result_sizes_ptr = result_sizes.data_ptr<int64_t>();
+  int64_t* result_strides_ptr = result_strides.data_ptr<int64_t>();
+  int64_t rows = 0;
+  for (int64_t i = 0; i < degree; i++) {
+    torch::nested_tensor::impl::ConstituentView view = impl->constituent_view(i);
+    ::nested_tensor::cpu::ConvImage& image = images[i];
+    image.offset = view.offset;
+    image.height = view.sizes[1];
+    image.width = view.sizes[2];
+    image.stride_c = view.strides[0];
+    image.stride_h = view.strides[1];
+    image.stride_w = view.strides[2];
+    const int64_t extent_h = image.height + 2 * params.pad_h -
+        params.dilation_h * (params.kernel_h - 1) - 1;
+    const int64_t extent_w = image.width + 2 * params.pad_w -
+        params.dilation_w * (params.kernel_w - 1) - 1;
+    if (extent_h < 0 || extent_w < 0) {
+      return Tensor();
+    }
+    image.output_height = extent_h / params.stride_h + 1;
+    image.output_width = extent_w / params.stride_w + 1;
+    rows += image.output_height * image.output_width;
+    row_offsets[i + 1] = rows;
+    result_sizes_ptr[i * 3] = out_channels;
+    result_sizes_ptr[i * 3 + 1] = image.output_height;
+    result_sizes_ptr[i * 3 + 2] = image.output_width;
+    result_strides_ptr[i * 3] = 1;
+    result_strides_ptr[i * 3 + 1] = image.output_width * out_channels;
+    result_strides_ptr[i * 3 + 2] = out_channels;
+  }
+  const int64_t structure = impl->get_nested_size().structure();
+  EfficientSizeNode result_size(structure, result_sizes);
+  EfficientSizeNode result_stride(structure, result_strides);
+
+  const bool channels_last =
+      get_is_contiguous(input, c10::MemoryFormat::ChannelsLast);
+  const int64_t kernel_columns = params.kernel_h * params.kernel_w * group_channels;
+  const int64_t out_group_channels = out_channels / groups;
+  const bool direct = channels_last && groups == 1 &&
+      params.kernel_h == 1 && params.kernel_w == 1 && params.stride_h == 1 &&
+      params.stride_w == 1 && params.pad_h == 0 && params.pad_w == 0 &&
+      buffer.numel() == rows * channels;
+  Tensor weight_matrix =
+      weight.permute({0, 2, 3, 1}).reshape({out_channels, kernel_columns});
+  Tensor bias_ = bias ? bias->contiguous() : Tensor();
+  Tensor output = empty_buffer(rows * out_channels, buffer.options());
+  Tensor output_matrix = output.view({rows, out_channels});
+  const int64_t column_bytes = groups * kernel_columns * buffer.element_size();
+  const int64_t tile_rows =
+      ::nested_tensor::cpu::rows_per_tile(rows, column_bytes, 1 << 20);
+  const int64_t num_tiles = (rows + tile_rows - 1) / tile_rows;
+  at::ThreadLocalState state;
+  at::parallel_for(0, num_tiles, 1, [&](int64_t begin, int64_t end) {
+    at::ThreadLocalStateGuard guard(state);
+    Tensor columns;
+    if (!direct) {
+      columns = at::empty({tile_rows, groups * kernel_columns}, buffer.options());
+    }
+    for (int64_t tile = begin; tile < end; tile++) {
+      const int64_t row_begin = tile * tile_rows;
+      const int64_t row_count = std::min(tile_rows, rows - row_begin);
+      Tensor tile_columns;
+      if (direct) {
+        tile_columns =
+            buffer.view({rows, channels}).narrow(0, row_begin, row_count);
+      } else {
+        tile_columns = columns.narrow(0, 0, row_count);
+        AT_DISPATCH_FLOATING_TYPES_AND(
+            kBFloat16, dtype, "NestedTensor_im2col", [&] {
+              ::nested_tensor::cpu::im2col_kernel<scalar_t>(
+                  buffer.data_ptr<scalar_t>(),
+                  images.data(),
+                  row_offsets.data(),
+                  degree,
+                  params,
+                  channels,
+                  groups,
+                  row_begin,
+                  row_begin + row_count,
+                  tile_columns.data_ptr<scalar_t>());
+            });
+      }
+      Tensor output_tile = output_matrix.narrow(0, row_begin, row_count);
+      for (int64_t g = 0; g < groups; g++) {
+        Tensor output_group =
+            output_tile.narrow(1, g * out_group_channels, out_group_channels);
+        at::mm_out(
+            output_group,
+            tile_columns.narrow(1, g * kernel_columns, kernel_columns),
+            weight_matrix.narrow(0, g * out_group_channels, out_group_channels)
+                .t());
+      }
+      if (bias_.defined() ||
+          activation != ::nested_tensor::cpu::Activation::None) {
+        AT_DISPATCH_FLOATING_TYPES_AND(
+            kBFloat16, dtype, "NestedTensor_conv2d_epilogue", [&] {
+              ::nested_tensor::cpu::linear_epilogue_kernel<scalar_t>(
+                  output_tile.data_ptr<scalar_t>(),
+                  bias_.defined() ? bias_.data_ptr<scalar_t>() : nullptr,
+                  nullptr,
+                  row_count,
+                  out_channels,
+                  activation);
+            });
+      }
+    }
+  });
+  Tensor result = wrap_buffer(std::move(output), result_size, result_stride);
+  if (channels_last) {
+    return result;
+  }
+  return NestedTensor_contiguous(result);
+}
+
+} // namespace
+
 Tensor NestedTensor_conv2d(
     const Tensor& input_,
     const Tensor& weight,
@@ -74,6 +260,18 @@ Tensor NestedTensor_conv2d(
     }
   }
 #endif
+  Tensor cpu_result = _conv2d_cpu(
+      input,
+      weight,
+      bias,
+      stride,
+      padding,
+      dilation,
+      groups,
+      ::nested_tensor::cpu::Activation::None);
+  if (cpu_result.defined()) {
+    return cpu_result;
+  }
   if (input.dtype() == torch::kFloat16) {
     at::Tensor data = to_padded_tensor(input, 0);
     at::Tensor result_data = at::conv2d(data, weight, bias, stride, padding, dilation, groups);
@@ -89,7 +287,7 @@ Tensor NestedTensor_conv2d(
     return result;
   }
   if (bias) {
-      return map_nested_tensor(
+      return parallel_map_nested_tensor(
           [&stride, &padding, &dilation, &groups](at::Tensor input, at::Tensor weight, at::Tensor bias) {
             return at::conv2d(input.unsqueeze(0), weight, bias, stride, padding, dilation, groups).squeeze(0);
           },
@@ -97,7 +295,7 @@ Tensor NestedTensor_conv2d(
           weight,
           *bias);
   }
-  return map_nested_tensor(
+  return parallel_map_nested_tensor(
       [&stride, &padding, &dilation, &groups](at::Tensor input, at::Tensor weight) {
       return at::conv2d(input.unsqueeze(0), weight, c10::nullopt, stride, padding, dilation, groups).squeeze(0);
       },
@@ -163,6 +361,18 @@ Tensor NestedTensor_cudnn_convolution_relu(
     }
   }
 #endif
+  Tensor cpu_result = _conv2d_cpu(
+      input,
+      weight,
+      bias,
+      stride,
+      padding,
+      dilation,
+      groups,
+      ::nested_tensor::cpu::Activation::Relu);
+  if (cpu_result.defined()) {
+    return cpu_result;
+  }
   if (input.dtype() == torch::kFloat16) {
     at::Tensor data = to_padded_tensor(input, 0);
     at::Tensor result_data = at::cudnn_convolution_relu(data, weight, bias, stride, padding, dilation, groups);
@@ -194,8 +404,74 @@ Tensor NestedTensor_cudnn_convolution_relu(
       weight);
 }
 
+// Convolution followed by inference mode batch norm and an optional relu.
+// The batch norm is folded into the weight and bias of the convolution, as
+// in fuser.py, so on CPU the scale, shift and relu are all applied in the
+// epilogue of the convolution engine.
+Tensor NestedTensor_conv_bn_relu(
+    const Tensor& input,
+    const Tensor& weight,
+    const c10::optional<Tensor>& bias,
+    const Tensor& running_mean,
+    const Tensor& running_var,
+    const c10::optional<Tensor>& bn_weight,
+    const c10::optional<Tensor>& bn_bias,
+    double eps,
+    IntArrayRef stride,
+    IntArrayRef padding,
+    IntArrayRef dilation,
+    int64_t groups,
+    bool relu) {
+  TORCH_CHECK(get_dim(input) == 4, "Expected input to be dim 4, but got ", get_dim(input), ".");
+  const int64_t out_channels = weight.size(0);
+  TORCH_CHECK(
+      running_mean.numel() == out_channels &&
+          running_var.numel() == out_channels,
+      "Expected running_mean and running_var to have ",
+      out_channels,
+      " elements.");
+  const ScalarType acc_dtype =
+      weight.scalar_type() == kDouble ? kDouble : kFloat;
+  Tensor scale = at::rsqrt(running_var.to(acc_dtype) + eps);
+  if (bn_weight) {
+    scale = scale * bn_weight->to(acc_dtype);
+  }
+  Tensor shift = bias ? bias->to(acc_dtype) - running_mean.to(acc_dtype)
+                      : -running_mean.to(acc_dtype);
+  shift = shift * scale;
+  if (bn_bias) {
+    shift = shift + bn_bias->to(acc_dtype);
+  }
+  Tensor folded_weight =
+      (weight.to(acc_dtype) * scale.reshape({-1, 1, 1, 1}))
+          .to(weight.scalar_type());
+  Tensor folded_bias = shift.to(weight.scalar_type());
+  Tensor cpu_result = _conv2d_cpu(
+      input,
+      folded_weight,
+      folded_bias,
+      stride,
+      padding,
+      dilation,
+      groups,
+      relu ? ::nested_tensor::cpu::Activation::Relu
+           : ::nested_tensor::cpu::Activation::None);
+  if (cpu_result.defined()) {
+    return cpu_result;
+  }
+  Tensor result = at::conv2d(
+      input, folded_weight, folded_bias, stride, padding, dilation, groups);
+  return relu ? at::relu(result) : result;
+}
+
 TORCH_LIBRARY_IMPL(aten, NestedTensor, m) {
   nt_impl(m, "conv2d", NestedTensor_conv2d);
   nt_impl(m, "cudnn_convolution_relu", NestedTensor_cudnn_convolution_relu);
 }
+
+TORCH_LIBRARY_FRAGMENT(nestedtensor, m) {
+  m.def(
+      "conv_bn_relu(Tensor input, Tensor weight, Tensor? bias, Tensor running_mean, Tensor running_var, Tensor? bn_weight=None, Tensor? bn_bias=None, float eps=1e-05, int[2] stride=1, int[2] padding=0, int[2] dilation=1, int groups=1, bool relu=True) -> Tensor");
+  m.impl("conv_bn_relu", NestedTensorKey, TORCH_FN(NestedTensor_conv_bn_relu));
+}
 } // namespace at
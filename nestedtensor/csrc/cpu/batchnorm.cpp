@@ -0,0 +1,70 @@
+#include <ATen/ATen.h>
+#include <ATen/Parallel.h>
+#include <nestedtensor/csrc/cpu/batchnorm.h>
+#include <algorithm>
+
+namespace nested_tensor {
+namespace cpu {
+
+template <typename T>
+void channel_affine_kernel(
+    const T* input,
+    T* output,
+    const at::opmath_type<T>* scale,
+    const at::opmath_type<T>* shift,
+    int64_t channels,
+    const int64_t* plane_offsets,
+    int64_t num_planes,
+    int64_t numel) {
+  using acc_t = at::opmath_type<T>;
+  if (plane_offsets == nullptr) {
+    const int64_t rows = channels == 0 ? 0 : numel / channels;
+    const int64_t grain_size = std::max<int64_t>(
+        at::internal::GRAIN_SIZE / std::max<int64_t>(channels, 1), 1);
+    at::parallel_for(0, rows, grain_size, [&](int64_t begin, int64_t end) {
+      for (int64_t row = begin; row < end; row++) {
+        const T* row_input = input + row * channels;
+        T* row_output = output + row * channels;
+        for (int64_t c = 0; c < channels; c++) {
+          row_output[c] = static_cast<T>(
+              static_cast<acc_t>(row_input[c]) * scale[c] + shift[c]);
+        }
+      }
+    });
+    return;
+  }
+  const int64_t grain_size = std::max<int64_t>(
+      at::internal::GRAIN_SIZE * num_planes / std::max<int64_t>(numel, 1), 1);
+  at::parallel_for(0, num_planes, grain_size, [&](int64_t begin, int64_t end) {
+    for (int64_t p = begin; p < end; p++) {
+      const acc_t plane_scale = scale[p % channels];
+      const acc_t plane_shift = shift[p % channels];
+      const T* plane_input = input + plane_offsets[p];
+      T* plane_output = output + plane_offsets[p];
+      const int64_t length = plane_offsets[p + 1] - plane_offsets[p];
+      for (int64_t j = 0; j < length; j++) {
+        plane_output[j] = static_cast<T>(
+            static_cast<acc_t>(plane_input[j]) * plane_scale + plane_shift);
+      }
+    }
+  });
+}
+
+#define INSTANTIATE_BATCH_NORM_KERNELS(T) \
+  template void channel_affine_kernel<T>( \
+      const T*,                           \
+      T*,                                 \
+      const at::opmath_type<T>*,          \
+      const at::opmath_type<T>*,          \
+      int64_t,                            \
+      const int64_t*,                     \
+      int64_t,                            \
+      int64_t);
+
+INSTANTIATE_BATCH_NORM_KERNELS(float)
+INSTANTIATE_BATCH_NORM_KERNELS(double)
+INSTANTIATE_BATCH_NORM_KERNELS(c10::BFloat16)
+#undef INSTANTIATE_BATCH_NORM_KERNELS
+
+} // namespace cpu
+} // namespace nested_tensor
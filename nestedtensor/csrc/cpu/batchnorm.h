@@ -0,0 +1,30 @@
+#pragma once
+
+#include <ATen/OpMathType.h>
+#include <cstdint>
+
+namespace nested_tensor {
+namespace cpu {
+
+// Computes output = input * scale[c] + shift[c] for every
+// element of a packed buffer of numel elements, where c is the channel of
+// the element. output may alias input. If plane_offsets is null the buffer
+// is channels last, i.e. a contiguous [numel / channels, channels] matrix.
+// Otherwise it is channels first and plane_offsets holds num_planes + 1
+// offsets that delimit contiguous planes of a single channel each, with the
+// channels of every constituent in order, so that plane p has channel
+// p % channels. This is batch norm in inference mode with its statistics
+// folded into scale and shift.
+template <typename T>
+void channel_affine_kernel(
+    const T* input,
+    T* output,
+    const at::opmath_type<T>* scale,
+    const at::opmath_type<T>* shift,
+    int64_t channels,
+    const int64_t* plane_offsets,
+    int64_t num_planes,
+    int64_t numel);
+
+} // namespace cpu
+} // namespace nested_tensor
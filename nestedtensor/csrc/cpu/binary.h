@@ -0,0 +1,158 @@
+#pragma once
+
+#include <ATen/OpMathType.h>
+#include <ATen/Parallel.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace nested_tensor {
+namespace cpu {
+
+// A contiguous run of elements of a packed NestedTensor buffer together with
+// the offset of the first element it is combined with in the other operand.
+// Within a run the other operand advances by a fixed inner stride, which is
+// 0 if it broadcasts along the innermost dimension and 1 otherwise.
+struct BroadcastRow {
+  int64_t offset;
+  int64_t other_offset;
+  int64_t length;
+};
+
+// Computes
+//   output[offset + j] = op(input[offset + j], other[other_offset + j * inner_stride])
+// for every row. output may alias input. numel is the total length of all
+// rows and is only used to pick a grain size. This kernel is defined in the
+// header, because it is instantiated with the functors of each binary op.
+template <typename T, typename out_t, typename F>
+void broadcast_binary_kernel(
+    const T* input,
+    const T* other,
+    out_t* output,
+    const BroadcastRow* rows,
+    int64_t num_rows,
+    int64_t numel,
+    int64_t inner_stride,
+    const F& op) {
+  if (num_rows == 0) {
+    return;
+  }
+  const int64_t grain_size = std::max<int64_t>(
+      at::internal::GRAIN_SIZE * num_rows / std::max<int64_t>(numel, 1), 1);
+  at::parallel_for(0, num_rows, grain_size, [&](int64_t begin, int64_t end) {
+    for (int64_t r = begin; r < end; r++) {
+      const BroadcastRow& row = rows[r];
+      const T* row_input = input + row.offset;
+      const T* row_other = other + row.other_offset;
+      out_t* row_output = output + row.offset;
+      if (inner_stride == 0) {
+        const T value = *row_other;
+        for (int64_t j = 0; j < row.length; j++) {
+          row_output[j] = op(row_input[j], value);
+        }
+      } else {
+        for (int64_t j = 0; j < row.length; j++) {
+          row_output[j] = op(row_input[j], row_other[j]);
+        }
+      }
+    }
+  });
+}
+
+// Functors for broadcast_binary_kernel. They match the CPU semantics of the
+// corresponding ATen ops for floating point types and compute in
+// at::opmath_type<T>.
+
+struct AddOp {
+  double alpha;
+  template <typename T>
+  T operator()(T a, T b) const {
+    using acc_t = at::opmath_type<T>;
+    return static_cast<T>(
+        static_cast<acc_t>(a) +
+        static_cast<acc_t>(alpha) * static_cast<acc_t>(b));
+  }
+};
+
+struct SubOp {
+  double alpha;
+  template <typename T>
+  T operator()(T a, T b) const {
+    using acc_t = at::opmath_type<T>;
+    return static_cast<T>(
+        static_cast<acc_t>(a) -
+        static_cast<acc_t>(alpha) * static_cast<acc_t>(b));
+  }
+};
+
+struct MulOp {
+  template <typename T>
+  T operator()(T a, T b) const {
+    using acc_t = at::opmath_type<T>;
+    return static_cast<T>(static_cast<acc_t>(a) * static_cast<acc_t>(b));
+  }
+};
+
+struct DivOp {
+  template <typename T>
+  T operator()(T a, T b) const {
+    using acc_t = at::opmath_type<T>;
+    return static_cast<T>(static_cast<acc_t>(a) / static_cast<acc_t>(b));
+  }
+};
+
+struct PowOp {
+  template <typename T>
+  T operator()(T a, T b) const {
+    using acc_t = at::opmath_type<T>;
+    return static_cast<T>(
+        std::pow(static_cast<acc_t>(a), static_cast<acc_t>(b)));
+  }
+};
+
+struct Atan2Op {
+  template <typename T>
+  T operator()(T a, T b) const {
+    using acc_t = at::opmath_type<T>;
+    return static_cast<T>(
+        std::atan2(static_cast<acc_t>(a), static_cast<acc_t>(b)));
+  }
+};
+
+// Python style remainder, which takes the sign of the divisor.
+struct RemainderOp {
+  template <typename T>
+  T operator()(T a, T b) const {
+    using acc_t = at::opmath_type<T>;
+    const acc_t b_ = static_cast<acc_t>(b);
+    acc_t mod = std::fmod(static_cast<acc_t>(a), b_);
+    if ((mod != 0) && ((b_ < 0) != (mod < 0))) {
+      mod += b_;
+    }
+    return static_cast<T>(mod);
+  }
+};
+
+struct EqOp {
+  template <typename T>
+  bool operator()(T a, T b) const {
+    return a == b;
+  }
+};
+
+struct NeOp {
+  template <typename T>
+  bool operator()(T a, T b) const {
+    return a != b;
+  }
+};
+
+struct GeOp {
+  template <typename T>
+  bool operator()(T a, T b) const {
+    return a >= b;
+  }
+};
+
+} // namespace cpu
+} // namespace nested_tensor
@@ -0,0 +1,56 @@
+#include <ATen/Parallel.h>
+#include <nestedtensor/csrc/cpu/cat.h>
+#include <nestedtensor/csrc/cpu/parallel.h>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace nested_tensor {
+namespace cpu {
+
+void cat_kernel(
+    const char* const* inputs,
+    int64_t num_inputs,
+    const int64_t* input_offsets,
+    const int64_t* chunks,
+    char* output,
+    const CatSegment* segments,
+    int64_t num_segments) {
+  std::vector<int64_t> row_offsets(num_segments + 1, 0);
+  int64_t nbytes = 0;
+  for (int64_t i = 0; i < num_segments; i++) {
+    row_offsets[i + 1] = row_offsets[i] + segments[i].outer;
+    nbytes += segments[i].outer * segments[i].row_size;
+  }
+  const int64_t total_rows = row_offsets[num_segments];
+  if (total_rows == 0) {
+    return;
+  }
+  const int64_t grain_size = std::max<int64_t>(
+      at::internal::GRAIN_SIZE * total_rows / std::max<int64_t>(nbytes, 1),
+      1);
+  at::parallel_for(0, total_rows, grain_size, [&](int64_t begin, int64_t end) {
+    for_each_segment_index(
+        row_offsets.data(),
+        num_segments,
+        begin,
+        end,
+        [&](int64_t i, int64_t o) {
+          const CatSegment& segment = segments[i];
+          char* row = output + segment.output_offset + o * segment.row_size;
+          for (int64_t k = 0; k < num_inputs; k++) {
+            const int64_t chunk = chunks[i * num_inputs + k];
+            if (chunk > 0) {
+              std::memcpy(
+                  row,
+                  inputs[k] + input_offsets[i * num_inputs + k] + o * chunk,
+                  chunk);
+            }
+            row += chunk;
+          }
+        });
+  });
+}
+
+} // namespace cpu
+} // namespace nested_tensor
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+
+namespace nested_tensor {
+namespace cpu {
+
+// One output constituent of a concatenation along a tensor dimension. The
+// constituent starts at output_offset and consists of outer rows of
+// row_size bytes. Each row is made up of one contiguous chunk of every
+// input, in order.
+struct CatSegment {
+  int64_t output_offset;
+  int64_t outer;
+  int64_t row_size;
+};
+
+// Gathers the rows of all segments in parallel. For segment i and input k,
+// input_offsets[i * num_inputs + k] is the byte offset of the first chunk
+// within inputs[k] and chunks[i * num_inputs + k] is the size of a chunk in
+// bytes. Subsequent chunks of an input follow each other without gaps.
+// Since only bytes are moved, the kernel works for any dtype.
+void cat_kernel(
+    const char* const* inputs,
+    int64_t num_inputs,
+    const int64_t* input_offsets,
+    const int64_t* chunks,
+    char* output,
+    const CatSegment* segments,
+    int64_t num_segments);
+
+} // namespace cpu
+} // namespace nested_tensor
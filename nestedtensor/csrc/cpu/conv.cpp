@@ -0,0 +1,87 @@
+#include <ATen/ATen.h>
+#include <nestedtensor/csrc/cpu/conv.h>
+#include <nestedtensor/csrc/cpu/parallel.h>
+#include <algorithm>
+
+namespace nested_tensor {
+namespace cpu {
+
+template <typename T>
+void im2col_kernel(
+    const T* input,
+    const ConvImage* images,
+    const int64_t* row_offsets,
+    int64_t num_images,
+    const ConvParams& params,
+    int64_t channels,
+    int64_t groups,
+    int64_t row_begin,
+    int64_t row_end,
+    T* columns) {
+  const int64_t group_channels = channels / groups;
+  const int64_t kernel_size = params.kernel_h * params.kernel_w;
+  const int64_t width = groups * kernel_size * group_channels;
+  for_each_segment_index(
+      row_offsets,
+      num_images,
+      row_begin,
+      row_end,
+      [&](int64_t i, int64_t pixel) {
+        const ConvImage& image = images[i];
+        const int64_t oh = pixel / image.output_width;
+        const int64_t ow = pixel % image.output_width;
+        const T* image_input = input + image.offset;
+        T* row_columns =
+            columns + (row_offsets[i] + pixel - row_begin) * width;
+        for (int64_t g = 0; g < groups; g++) {
+          const T* group_input =
+              image_input + g * group_channels * image.stride_c;
+          for (int64_t kh = 0; kh < params.kernel_h; kh++) {
+            const int64_t ih =
+                oh * params.stride_h - params.pad_h + kh * params.dilation_h;
+            for (int64_t kw = 0; kw < params.kernel_w; kw++) {
+              const int64_t iw =
+                  ow * params.stride_w - params.pad_w + kw * params.dilation_w;
+              T* dst = row_columns +
+                  (g * kernel_size + kh * params.kernel_w + kw) *
+                      group_channels;
+              if (ih < 0 || ih >= image.height || iw < 0 ||
+                  iw >= image.width) {
+                std::fill(dst, dst + group_channels, static_cast<T>(0));
+                continue;
+              }
+              const T* src =
+                  group_input + ih * image.stride_h + iw * image.stride_w;
+              if (image.stride_c == 1) {
+                std::copy(src, src + group_channels, dst);
+              } else {
+                for (int64_t c = 0; c < group_channels; c++) {
+                  dst[c] = src[c * image.stride_c];
+                }
+              }
+            }
+          }
+        }
+      });
+}
+
+#define INSTANTIATE_CONV_KERNELS(T) \
+  template void im2col_kernel<T>(   \
+      const T*,                     \
+      const ConvImage*,             \
+      const int64_t*,               \
+      int64_t,                      \
+      const ConvParams&,            \
+      int64_t,                      \
+      int64_t,                      \
+      int64_t,                      \
+      int64_t,                      \
+      T*);
+
+INSTANTIATE_CONV_KERNELS(float)
+INSTANTIATE_CONV_KERNELS(double)
+INSTANTIATE_CONV_KERNELS(c10::BFloat16)
+#undef INSTANTIATE_CONV_KERNELS
+
+} // namespace cpu
+} // namespace nested_tensor
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+
+namespace nested_tensor {
+namespace cpu {
+
+// The geometry of a 2d convolution or pooling window.
+struct ConvParams {
+  int64_t kernel_h;
+  int64_t kernel_w;
+  int64_t stride_h;
+  int64_t stride_w;
+  int64_t pad_h;
+  int64_t pad_w;
+  int64_t dilation_h;
+  int64_t dilation_w;
+};
+
+// An image of a ragged batch of [channels, height, width] images. It is
+// read from input + offset with the given strides, so it may be stored
+// channels first or channels last.
+struct ConvImage {
+  int64_t offset;
+  int64_t height;
+  int64_t width;
+  int64_t stride_c;
+  int64_t stride_h;
+  int64_t stride_w;
+  int64_t output_height;
+  int64_t output_width;
+};
+
+// Writes the im2col columns for the output rows [row_begin, row_end) of a
+// ragged batch of images into the contiguous matrix columns. Each row holds
+// groups * kernel_h * kernel_w * (channels / groups) values, ordered by
+// group, kernel row, kernel column and channel, so that the columns of
+// group g multiplied with the weight of group g permuted to
+// [out_channels, kernel_h, kernel_w, channels / groups] give the output.
+// Padding is filled with 0. The output pixels of image i are the rows
+// [row_offsets[i], row_offsets[i + 1]) of the packed convolution output, so
+// row_offsets has num_images + 1 entries. This kernel is serial, because it
+// is meant to fill a tile of columns right before it is consumed by a GEMM.
+template <typename T>
+void im2col_kernel(
+    const T* input,
+    const ConvImage* images,
+    const int64_t* row_offsets,
+    int64_t num_images,
+    const ConvParams& params,
+    int64_t channels,
+    int64_t groups,
+    int64_t row_begin,
+    int64_t row_end,
+    T* columns);
+
+} // namespace cpu
+} // namespace nested_tensor
@@ -0,0 +1,164 @@
+#include <ATen/ATen.h>
+#include <ATen/OpMathType.h>
+#include <ATen/Parallel.h>
+#include <nestedtensor/csrc/cpu/interpolate.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace nested_tensor {
+namespace cpu {
+
+namespace {
+
+template <typename acc_t>
+acc_t _scale(int64_t input_size, int64_t output_size, double scale) {
+  return scale > 0 ? static_cast<acc_t>(1.0 / scale)
+                   : static_cast<acc_t>(input_size) / output_size;
+}
+
+int64_t _nearest_index(
+    int64_t output_index,
+    int64_t input_size,
+    int64_t output_size,
+    double scale) {
+  if (output_size == input_size) {
+    return output_index;
+  }
+  if (output_size == 2 * input_size) {
+    return output_index >> 1;
+  }
+  const float scale_ = _scale<float>(input_size, output_size, scale);
+  return std::min(
+      static_cast<int64_t>(std::floor(output_index * scale_)), input_size - 1);
+}
+
+// The two input indices and their weights that output index o is
+// interpolated from, see area_pixel_compute_source_index in ATen.
+template <typename acc_t>
+struct LinearIndex {
+  int64_t index0;
+  int64_t offset1;
+  acc_t lambda0;
+  acc_t lambda1;
+};
+
+template <typename acc_t>
+std::vector<LinearIndex<acc_t>> _linear_indices(
+    int64_t input_size,
+    int64_t output_size,
+    double scale,
+    bool align_corners) {
+  acc_t scale_;
+  if (align_corners) {
+    scale_ = output_size > 1
+        ? static_cast<acc_t>(input_size - 1) / (output_size - 1)
+        : acc_t(0);
+  } else {
+    scale_ = _scale<acc_t>(input_size, output_size, scale);
+  }
+  std::vector<LinearIndex<acc_t>> indices(output_size);
+  for (int64_t o = 0; o < output_size; o++) {
+    acc_t real = align_corners
+        ? scale_ * o
+        : std::max(scale_ * (o + acc_t(0.5)) - acc_t(0.5), acc_t(0));
+    LinearIndex<acc_t>& index = indices[o];
+    index.index0 = std::min(static_cast<int64_t>(real), input_size - 1);
+    index.offset1 = index.index0 < input_size - 1 ? 1 : 0;
+    index.lambda1 = std::min(
+        std::max(real - index.index0, acc_t(0)), acc_t(1));
+    index.lambda0 = acc_t(1) - index.lambda1;
+  }
+  return indices;
+}
+
+} // namespace
+
+template <typename T>
+void upsample2d_kernel(
+    const T* input,
+    T* output,
+    const ResizeImage* images,
+    int64_t num_images,
+    int64_t channels,
+    double scale_h,
+    double scale_w,
+    bool bilinear,
+    bool align_corners) {
+  using acc_t = at::opmath_type<T>;
+  const int64_t num_planes = num_images * channels;
+  int64_t output_numel = 0;
+  for (int64_t i = 0; i < num_images; i++) {
+    output_numel += channels * images[i].output_height * images[i].output_width;
+  }
+  if (num_planes == 0 || output_numel == 0) {
+    return;
+  }
+  const int64_t grain_size = std::max<int64_t>(
+      at::internal::GRAIN_SIZE * num_planes / output_numel, 1);
+  at::parallel_for(0, num_planes, grain_size, [&](int64_t begin, int64_t end) {
+    for (int64_t p = begin; p < end; p++) {
+      const ResizeImage& image = images[p / channels];
+      const int64_t c = p % channels;
+      const int64_t out_h = image.output_height;
+      const int64_t out_w = image.output_width;
+      const T* plane = input + image.input_offset + c * image.height * image.width;
+      T* out = output + image.output_offset + c * out_h * out_w;
+      if (!bilinear) {
+        std::vector<int64_t> w_index(out_w);
+        for (int64_t ow = 0; ow < out_w; ow++) {
+          w_index[ow] = _nearest_index(ow, image.width, out_w, scale_w);
+        }
+        for (int64_t oh = 0; oh < out_h; oh++) {
+          const T* row =
+              plane + _nearest_index(oh, image.height, out_h, scale_h) * image.width;
+          for (int64_t ow = 0; ow < out_w; ow++) {
+            out[oh * out_w + ow] = row[w_index[ow]];
+          }
+        }
+        continue;
+      }
+      const std::vector<LinearIndex<acc_t>> h_index =
+          _linear_indices<acc_t>(image.height, out_h, scale_h, align_corners);
+      const std::vector<LinearIndex<acc_t>> w_index =
+          _linear_indices<acc_t>(image.width, out_w, scale_w, align_corners);
+      for (int64_t oh = 0; oh < out_h; oh++) {
+        const LinearIndex<acc_t>& h = h_index[oh];
+        const T* row0 = plane + h.index0 * image.width;
+        const T* row1 = row0 + h.offset1 * image.width;
+        for (int64_t ow = 0; ow < out_w; ow++) {
+          const LinearIndex<acc_t>& w = w_index[ow];
+          const int64_t w0 = w.index0;
+          const int64_t w1 = w0 + w.offset1;
+          out[oh * out_w + ow] = static_cast<T>(
+              h.lambda0 *
+                  (w.lambda0 * static_cast<acc_t>(row0[w0]) +
+                   w.lambda1 * static_cast<acc_t>(row0[w1])) +
+              h.lambda1 *
+                  (w.lambda0 * static_cast<acc_t>(row1[w0]) +
+                   w.lambda1 * static_cast<acc_t>(row1[w1])));
+        }
+      }
+    }
+  });
+}
+
+#define INSTANTIATE_INTERPOLATE_KERNELS(T) \
+  template void upsample2d_kernel<T>(      \
+      const T*,                            \
+      T*,                                  \
+      const ResizeImage*,                  \
+      int64_t,                             \
+      int64_t,                             \
+      double,                              \
+      double,                              \
+      bool,                                \
+      bool);
+
+INSTANTIATE_INTERPOLATE_KERNELS(float)
+INSTANTIATE_INTERPOLATE_KERNELS(double)
+INSTANTIATE_INTERPOLATE_KERNELS(c10::BFloat16)
+#undef INSTANTIATE_INTERPOLATE_KERNELS
+
+} // namespace cpu
+} // namespace nested_tensor
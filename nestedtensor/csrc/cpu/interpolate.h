@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+
+namespace nested_tensor {
+namespace cpu {
+
+// An image of a ragged batch of contiguous [channels, height, width]
+// images that is resized to [channels, output_height, output_width]. The
+// input is stored at input_offset and the output at output_offset.
+struct ResizeImage {
+  int64_t input_offset;
+  int64_t height;
+  int64_t width;
+  int64_t output_offset;
+  int64_t output_height;
+  int64_t output_width;
+};
+
+// Resizes every image with nearest neighbor or bilinear interpolation in
+// parallel over the channels of all images. scale_h and scale_w are the
+// scale factors the output sizes were computed from, or non-positive if the
+// output sizes were given, and are used to map output to input coordinates
+// as in ATen's upsample_nearest2d and upsample_bilinear2d. align_corners
+// only applies to bilinear interpolation. Interpolation happens in
+// at::opmath_type<T>.
+template <typename T>
+void upsample2d_kernel(
+    const T* input,
+    T* output,
+    const ResizeImage* images,
+    int64_t num_images,
+    int64_t channels,
+    double scale_h,
+    double scale_w,
+    bool bilinear,
+    bool align_corners);
+
+} // namespace cpu
+} // namespace nested_tensor
@@ -0,0 +1,101 @@
+#include <ATen/ATen.h>
+#include <ATen/OpMathType.h>
+#include <ATen/Parallel.h>
+#include <nestedtensor/csrc/cpu/layernorm.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace nested_tensor {
+namespace cpu {
+
+// Each row is read once: the optional residual and bias are added while
+// the Welford statistics are accumulated and the sum is kept in a buffer
+// of opmath values. A second, branch-free pass over that buffer applies
+// the normalization and the affine transform.
+template <typename T>
+void layer_norm_kernel(
+    const T* input,
+    const T* residual,
+    const T* bias,
+    const T* gamma,
+    const T* beta,
+    T* output,
+    int64_t rows,
+    int64_t hidden,
+    double eps) {
+  using acc_t = at::opmath_type<T>;
+  if (hidden == 0) {
+    return;
+  }
+  const int64_t grain_size =
+      std::max<int64_t>(at::internal::GRAIN_SIZE / hidden, 1);
+  at::parallel_for(0, rows, grain_size, [&](int64_t begin, int64_t end) {
+    std::vector<acc_t> buffer(hidden);
+    acc_t* values = buffer.data();
+    for (int64_t row = begin; row < end; row++) {
+      const T* row_input = input + row * hidden;
+      T* row_output = output + row * hidden;
+      for (int64_t j = 0; j < hidden; j++) {
+        values[j] = static_cast<acc_t>(row_input[j]);
+      }
+      if (residual != nullptr) {
+        const T* row_residual = residual + row * hidden;
+        for (int64_t j = 0; j < hidden; j++) {
+          values[j] += static_cast<acc_t>(row_residual[j]);
+        }
+      }
+      if (bias != nullptr) {
+        for (int64_t j = 0; j < hidden; j++) {
+          values[j] += static_cast<acc_t>(bias[j]);
+        }
+      }
+      acc_t mean = 0;
+      acc_t m2 = 0;
+      for (int64_t j = 0; j < hidden; j++) {
+        const acc_t delta = values[j] - mean;
+        mean += delta / static_cast<acc_t>(j + 1);
+        m2 += delta * (values[j] - mean);
+      }
+      const acc_t rstd = acc_t(1) /
+          std::sqrt(m2 / static_cast<acc_t>(hidden) + static_cast<acc_t>(eps));
+      if (gamma != nullptr && beta != nullptr) {
+        for (int64_t j = 0; j < hidden; j++) {
+          row_output[j] = static_cast<T>(
+              (values[j] - mean) * rstd * static_cast<acc_t>(gamma[j]) +
+              static_cast<acc_t>(beta[j]));
+        }
+      } else if (gamma != nullptr) {
+        for (int64_t j = 0; j < hidden; j++) {
+          row_output[j] = static_cast<T>(
+              (values[j] - mean) * rstd * static_cast<acc_t>(gamma[j]));
+        }
+      } else {
+        for (int64_t j = 0; j < hidden; j++) {
+          row_output[j] = static_cast<T>((values[j] - mean) * rstd);
+        }
+      }
+    }
+  });
+}
+
+#define INSTANTIATE_LAYER_NORM_KERNELS(T) \
+  template void layer_norm_kernel<T>(     \
+      const T*,                           \
+      const T*,                           \
+      const T*,                           \
+      const T*,                           \
+      const T*,                           \
+      T*,                                 \
+      int64_t,                            \
+      int64_t,                            \
+      double);
+
+INSTANTIATE_LAYER_NORM_KERNELS(float)
+INSTANTIATE_LAYER_NORM_KERNELS(double)
+INSTANTIATE_LAYER_NORM_KERNELS(c10::Half)
+INSTANTIATE_LAYER_NORM_KERNELS(c10::BFloat16)
+#undef INSTANTIATE_LAYER_NORM_KERNELS
+
+} // namespace cpu
+} // namespace nested_tensor
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+
+namespace nested_tensor {
+namespace cpu {
+
+// Applies layer normalization to each row of a contiguous [rows, hidden]
+// matrix and writes the result to output, which may alias input.
+// If residual and/or bias are given, the normalized value is
+// x = input + residual + bias, where residual is [rows, hidden] and bias is
+// [hidden]; this mirrors fastertransformer's add_bias_input_layernorm.
+// gamma and beta are [hidden] and may be null to skip the affine step.
+// Mean and variance are computed with Welford's algorithm in
+// at::opmath_type<T>.
+template <typename T>
+void layer_norm_kernel(
+    const T* input,
+    const T* residual,
+    const T* bias,
+    const T* gamma,
+    const T* beta,
+    T* output,
+    int64_t rows,
+    int64_t hidden,
+    double eps);
+
+} // namespace cpu
+} // namespace nested_tensor
@@ -0,0 +1,116 @@
+#include <ATen/ATen.h>
+#include <ATen/OpMathType.h>
+#include <nestedtensor/csrc/cpu/linear.h>
+#include <cmath>
+
+namespace nested_tensor {
+namespace cpu {
+
+namespace {
+
+template <typename acc_t>
+struct IdentityOp {
+  acc_t operator()(acc_t x) const {
+    return x;
+  }
+};
+
+template <typename acc_t>
+struct ReluOp {
+  acc_t operator()(acc_t x) const {
+    return x > acc_t(0) ? x : acc_t(0);
+  }
+};
+
+template <typename acc_t>
+struct GeluOp {
+  acc_t operator()(acc_t x) const {
+    return acc_t(0.5) * x *
+        (acc_t(1) + std::erf(x * acc_t(0.70710678118654752440)));
+  }
+};
+
+template <typename acc_t>
+struct SiluOp {
+  acc_t operator()(acc_t x) const {
+    return x / (acc_t(1) + std::exp(-x));
+  }
+};
+
+// The loops are specialized on the activation and on the presence of bias
+// and residual so that the inner loop has no branches.
+template <typename T, typename F>
+void _linear_epilogue(
+    T* output,
+    const T* bias,
+    const T* residual,
+    int64_t rows,
+    int64_t cols,
+    const F& op) {
+  using acc_t = at::opmath_type<T>;
+  for (int64_t row = 0; row < rows; row++) {
+    T* row_output = output + row * cols;
+    const T* row_residual = residual == nullptr ? nullptr : residual + row * cols;
+    if (bias != nullptr && row_residual != nullptr) {
+      for (int64_t j = 0; j < cols; j++) {
+        row_output[j] = static_cast<T>(
+            op(static_cast<acc_t>(row_output[j]) + static_cast<acc_t>(bias[j])) +
+            static_cast<acc_t>(row_residual[j]));
+      }
+    } else if (bias != nullptr) {
+      for (int64_t j = 0; j < cols; j++) {
+        row_output[j] = static_cast<T>(
+            op(static_cast<acc_t>(row_output[j]) + static_cast<acc_t>(bias[j])));
+      }
+    } else if (row_residual != nullptr) {
+      for (int64_t j = 0; j < cols; j++) {
+        row_output[j] = static_cast<T>(
+            op(static_cast<acc_t>(row_output[j])) +
+            static_cast<acc_t>(row_residual[j]));
+      }
+    } else {
+      for (int64_t j = 0; j < cols; j++) {
+        row_output[j] = static_cast<T>(op(static_cast<acc_t>(row_output[j])));
+      }
+    }
+  }
+}
+
+} // namespace
+
+template <typename T>
+void linear_epilogue_kernel(
+    T* output,
+    const T* bias,
+    const T* residual,
+    int64_t rows,
+    int64_t cols,
+    Activation activation) {
+  using acc_t = at::opmath_type<T>;
+  switch (activation) {
+    case Activation::None:
+      _linear_epilogue(output, bias, residual, rows, cols, IdentityOp<acc_t>());
+      break;
+    case Activation::Relu:
+      _linear_epilogue(output, bias, residual, rows, cols, ReluOp<acc_t>());
+      break;
+    case Activation::Gelu:
+      _linear_epilogue(output, bias, residual, rows, cols, GeluOp<acc_t>());
+      break;
+    case Activation::Silu:
+      _linear_epilogue(output, bias, residual, rows, cols, SiluOp<acc_t>());
+      break;
+  }
+}
+
+#define INSTANTIATE_LINEAR_KERNELS(T)   \
+  template void linear_epilogue_kernel<T>( \
+      T*, const T*, const T*, int64_t, int64_t, Activation);
+
+INSTANTIATE_LINEAR_KERNELS(float)
+INSTANTIATE_LINEAR_KERNELS(double)
+INSTANTIATE_LINEAR_KERNELS(c10::BFloat16)
+#undef INSTANTIATE_LINEAR_KERNELS
+
+} // namespace cpu
+} // namespace nested_tensor
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+
+namespace nested_tensor {
+namespace cpu {
+
+// Activations that can be applied in the epilogue of a linear layer.
+enum class Activation { None, Relu, Gelu, Silu };
+
+// Computes output = activation(output + bias) + residual in place for a
+// contiguous [rows, cols] matrix, as the epilogue of a GEMM that produced
+// output. bias is [cols] and residual is [rows, cols]; either may be null.
+// Gelu is the exact, erf based variant. This kernel is serial, because it
+// is meant to run on a tile of the GEMM output while it is still in cache.
+// Computation happens in at::opmath_type<T>.
+template <typename T>
+void linear_epilogue_kernel(
+    T* output,
+    const T* bias,
+    const T* residual,
+    int64_t rows,
+    int64_t cols,
+    Activation activation);
+
+} // namespace cpu
+} // namespace nested_tensor
@@ -0,0 +1,135 @@
+#include <ATen/ATen.h>
+#include <ATen/Parallel.h>
+#include <c10/util/Exception.h>
+#include <nestedtensor/csrc/cpu/padding.h>
+#include <algorithm>
+
+namespace nested_tensor {
+namespace cpu {
+
+// Both kernels view a constituent of dimension 1 to 3 as a [rows0, rows1,
+// length] Tensor, padding missing leading dimensions with 1. Work is split
+// across (batch, row0, row1) of the padded Tensor and each row is a single
+// contiguous copy followed by a fill, which the compiler turns into memmove
+// and vectorized stores.
+namespace {
+
+struct RowShape {
+  int64_t rows0;
+  int64_t rows1;
+  int64_t length;
+};
+
+inline RowShape _row_shape(const int64_t* sizes, int64_t dim) {
+  RowShape shape;
+  shape.rows0 = dim == 3 ? sizes[0] : 1;
+  shape.rows1 = dim >= 2 ? sizes[dim - 2] : 1;
+  shape.length = sizes[dim - 1];
+  return shape;
+}
+
+inline int64_t _grain_size(int64_t length) {
+  return std::max<int64_t>(
+      at::internal::GRAIN_SIZE / std::max<int64_t>(length, 1), 1);
+}
+
+} // namespace
+
+template <typename T>
+void add_padding_kernel(
+    const T* input,
+    T* output,
+    T padding_value,
+    const int64_t* offsets,
+    const int64_t* input_sizes,
+    int64_t input_dim,
+    const std::vector<int64_t>& output_sizes,
+    int64_t batch_size) {
+  TORCH_CHECK(
+      input_dim >= 1 && input_dim <= 3,
+      "add_padding_kernel: Only supports constituents of dimension 1 to 3.");
+  const RowShape padded = _row_shape(output_sizes.data() + 1, input_dim);
+  const int64_t rows_per_batch = padded.rows0 * padded.rows1;
+  at::parallel_for(
+      0,
+      batch_size * rows_per_batch,
+      _grain_size(padded.length),
+      [&](int64_t begin, int64_t end) {
+        for (int64_t row = begin; row < end; row++) {
+          const int64_t batch_id = row / rows_per_batch;
+          const int64_t i0 = (row % rows_per_batch) / padded.rows1;
+          const int64_t i1 = (row % rows_per_batch) % padded.rows1;
+          const RowShape shape =
+              _row_shape(input_sizes + batch_id * input_dim, input_dim);
+          T* output_row = output + row * padded.length;
+          int64_t copied = 0;
+          if (i0 < shape.rows0 && i1 < shape.rows1) {
+            const T* input_row = input + offsets[batch_id] +
+                (i0 * shape.rows1 + i1) * shape.length;
+            std::copy(input_row, input_row + shape.length, output_row);
+            copied = shape.length;
+          }
+          std::fill(output_row + copied, output_row + padded.length, padding_value);
+        }
+      });
+}
+
+template <typename T>
+void remove_padding_kernel(
+    const T* input,
+    T* output,
+    const int64_t* offsets,
+    const int64_t* input_sizes,
+    const int64_t* output_sizes,
+    int64_t output_dim,
+    int64_t batch_size) {
+  TORCH_CHECK(
+      output_dim >= 1 && output_dim <= 3,
+      "remove_padding_kernel: Only supports constituents of dimension 1 to 3.");
+  const RowShape padded = _row_shape(input_sizes + 1, output_dim);
+  const int64_t rows_per_batch = padded.rows0 * padded.rows1;
+  at::parallel_for(
+      0,
+      batch_size * rows_per_batch,
+      _grain_size(padded.length),
+      [&](int64_t begin, int64_t end) {
+        for (int64_t row = begin; row < end; row++) {
+          const int64_t batch_id = row / rows_per_batch;
+          const int64_t i0 = (row % rows_per_batch) / padded.rows1;
+          const int64_t i1 = (row % rows_per_batch) % padded.rows1;
+          const RowShape shape =
+              _row_shape(output_sizes + batch_id * output_dim, output_dim);
+          if (i0 < shape.rows0 && i1 < shape.rows1) {
+            const T* input_row = input + row * padded.length;
+            T* output_row = output + offsets[batch_id] +
+                (i0 * shape.rows1 + i1) * shape.length;
+            std::copy(input_row, input_row + shape.length, output_row);
+          }
+        }
+      });
+}
+
+#define INSTANTIATE_PADDING_KERNELS(T, _) \
+  template void add_padding_kernel<T>(    \
+      const T*,                           \
+      T*,                                 \
+      T,                                  \
+      const int64_t*,                     \
+      const int64_t*,                     \
+      int64_t,                            \
+      const std::vector<int64_t>&,        \
+      int64_t);                           \
+  template void remove_padding_kernel<T>( \
+      const T*,                           \
+      T*,                                 \
+      const int64_t*,                     \
+      const int64_t*,                     \
+      const int64_t*,                     \
+      int64_t,                            \
+      int64_t);
+
+AT_FORALL_SCALAR_TYPES_AND3(Bool, Half, BFloat16, INSTANTIATE_PADDING_KERNELS)
+#undef INSTANTIATE_PADDING_KERNELS
+
+} // namespace cpu
+} // namespace nested_tensor
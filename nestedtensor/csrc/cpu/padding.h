@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace nested_tensor {
+namespace cpu {
+
+// Copies the constituents of a contiguous NestedTensor of constituent
+// dimension input_dim (1 to 3) into a padded Tensor of size output_sizes,
+// which includes the batch dimension. offsets are the element offsets of
+// each constituent within input and input_sizes are the constituent sizes
+// stored as a [batch_size, input_dim] matrix.
+template <typename T>
+void add_padding_kernel(
+    const T* input,
+    T* output,
+    T padding_value,
+    const int64_t* offsets,
+    const int64_t* input_sizes,
+    int64_t input_dim,
+    const std::vector<int64_t>& output_sizes,
+    int64_t batch_size);
+
+// Inverse of add_padding_kernel. input_sizes are the sizes of the padded
+// input including the batch dimension and output_sizes are the constituent
+// sizes stored as a [batch_size, output_dim] matrix.
+template <typename T>
+void remove_padding_kernel(
+    const T* input,
+    T* output,
+    const int64_t* offsets,
+    const int64_t* input_sizes,
+    const int64_t* output_sizes,
+    int64_t output_dim,
+    int64_t batch_size);
+
+} // namespace cpu
+} // namespace nested_tensor
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <ATen/Parallel.h>
+#include <algorithm>
+#include <cstdint>
+
+namespace nested_tensor {
+namespace cpu {
+
+// Calls fn(i, index - offsets[i]) for every index in [begin, end), where i
+// is the segment that contains index. offsets are the num_segments + 1
+// prefix offsets of the segments, so empty segments are skipped. The first
+// segment is found by binary search and the following ones by advancing
+// from it, which suits the contiguous ranges handed out by
+// at::parallel_for.
+template <typename F>
+void for_each_segment_index(
+    const int64_t* offsets,
+    int64_t num_segments,
+    int64_t begin,
+    int64_t end,
+    const F& fn) {
+  if (begin >= end) {
+    return;
+  }
+  int64_t i =
+      std::upper_bound(offsets, offsets + num_segments + 1, begin) -
+      offsets - 1;
+  for (int64_t index = begin; index < end; index++) {
+    while (index >= offsets[i + 1]) {
+      i++;
+    }
+    fn(i, index - offsets[i]);
+  }
+}
+
+// Returns the number of rows per tile if rows of row_bytes each are split
+// into tiles of at most tile_bytes, e.g. to keep a tile in L2. There is at
+// least one tile per thread and every tile has at least one row.
+inline int64_t rows_per_tile(
+    int64_t rows,
+    int64_t row_bytes,
+    int64_t tile_bytes) {
+  const int64_t num_threads = at::get_num_threads();
+  return std::max<int64_t>(
+      std::min<int64_t>(
+          tile_bytes / std::max<int64_t>(row_bytes, 1),
+          (rows + num_threads - 1) / num_threads),
+      1);
+}
+
+} // namespace cpu
+} // namespace nested_tensor
@@ -0,0 +1,243 @@
+#include <ATen/ATen.h>
+#include <ATen/OpMathType.h>
+#include <ATen/Parallel.h>
+#include <nestedtensor/csrc/cpu/parallel.h>
+#include <nestedtensor/csrc/cpu/pooling.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace nested_tensor {
+namespace cpu {
+
+namespace {
+
+// Calls fn(image, item) for every item of every image in parallel. An item
+// is a channel or an output pixel, depending on the memory format, and
+// work_per_item is the number of input values an item reads on average.
+template <typename F>
+void _parallel_for_each_item(
+    const PoolImage* images,
+    int64_t num_images,
+    int64_t channels,
+    bool channels_last,
+    int64_t work_per_item,
+    const F& fn) {
+  std::vector<int64_t> item_offsets(num_images + 1, 0);
+  for (int64_t i = 0; i < num_images; i++) {
+    const int64_t items = channels_last
+        ? images[i].output_height * images[i].output_width
+        : channels;
+    item_offsets[i + 1] = item_offsets[i] + items;
+  }
+  const int64_t total_items = item_offsets[num_images];
+  if (total_items == 0) {
+    return;
+  }
+  const int64_t grain_size = std::max<int64_t>(
+      at::internal::GRAIN_SIZE / std::max<int64_t>(work_per_item, 1), 1);
+  at::parallel_for(0, total_items, grain_size, [&](int64_t begin, int64_t end) {
+    for_each_segment_index(
+        item_offsets.data(),
+        num_images,
+        begin,
+        end,
+        [&](int64_t i, int64_t item) { fn(images[i], item); });
+  });
+}
+
+int64_t _average_work(
+    const PoolImage* images,
+    int64_t num_images,
+    int64_t channels,
+    bool channels_last) {
+  int64_t numel = 0;
+  int64_t items = 0;
+  for (int64_t i = 0; i < num_images; i++) {
+    numel += channels * images[i].height * images[i].width;
+    items += channels_last ? images[i].output_height * images[i].output_width
+                           : channels;
+  }
+  return numel / std::max<int64_t>(items, 1);
+}
+
+} // namespace
+
+template <typename T>
+void max_pool2d_kernel(
+    const T* input,
+    T* output,
+    const PoolImage* images,
+    int64_t num_images,
+    int64_t channels,
+    const ConvParams& params,
+    bool channels_last) {
+  const T lowest = -std::numeric_limits<T>::infinity();
+  // The input window of output pixel (oh, ow) is the intersection of the
+  // dilated kernel with the image.
+  auto window = [](
+                    int64_t o,
+                    int64_t stride,
+                    int64_t pad,
+                    int64_t dilation,
+                    int64_t kernel,
+                    int64_t size,
+                    int64_t& begin,
+                    int64_t& end) {
+    begin = o * stride - pad;
+    end = std::min(begin + (kernel - 1) * dilation + 1, size);
+    while (begin < 0) {
+      begin += dilation;
+    }
+  };
+  const int64_t work_per_item = channels_last
+      ? channels * params.kernel_h * params.kernel_w
+      : _average_work(images, num_images, channels, channels_last);
+  _parallel_for_each_item(
+      images,
+      num_images,
+      channels,
+      channels_last,
+      work_per_item,
+      [&](const PoolImage& image, int64_t item) {
+        const T* image_input = input + image.input_offset;
+        T* image_output = output + image.output_offset;
+        if (channels_last) {
+          const int64_t oh = item / image.output_width;
+          const int64_t ow = item % image.output_width;
+          int64_t h_begin, h_end, w_begin, w_end;
+          window(oh, params.stride_h, params.pad_h, params.dilation_h,
+                 params.kernel_h, image.height, h_begin, h_end);
+          window(ow, params.stride_w, params.pad_w, params.dilation_w,
+                 params.kernel_w, image.width, w_begin, w_end);
+          T* out = image_output + item * channels;
+          std::fill(out, out + channels, lowest);
+          for (int64_t h = h_begin; h < h_end; h += params.dilation_h) {
+            for (int64_t w = w_begin; w < w_end; w += params.dilation_w) {
+              const T* in = image_input + (h * image.width + w) * channels;
+              for (int64_t c = 0; c < channels; c++) {
+                const T value = in[c];
+                if (value > out[c] || std::isnan(static_cast<float>(value))) {
+                  out[c] = value;
+                }
+              }
+            }
+          }
+          return;
+        }
+        const T* plane = image_input + item * image.height * image.width;
+        T* out = image_output + item * image.output_height * image.output_width;
+        for (int64_t oh = 0; oh < image.output_height; oh++) {
+          int64_t h_begin, h_end;
+          window(oh, params.stride_h, params.pad_h, params.dilation_h,
+                 params.kernel_h, image.height, h_begin, h_end);
+          for (int64_t ow = 0; ow < image.output_width; ow++) {
+            int64_t w_begin, w_end;
+            window(ow, params.stride_w, params.pad_w, params.dilation_w,
+                   params.kernel_w, image.width, w_begin, w_end);
+            T max_value = lowest;
+            for (int64_t h = h_begin; h < h_end; h += params.dilation_h) {
+              for (int64_t w = w_begin; w < w_end; w += params.dilation_w) {
+                const T value = plane[h * image.width + w];
+                if (value > max_value ||
+                    std::isnan(static_cast<float>(value))) {
+                  max_value = value;
+                }
+              }
+            }
+            out[oh * image.output_width + ow] = max_value;
+          }
+        }
+      });
+}
+
+template <typename T>
+void adaptive_avg_pool2d_kernel(
+    const T* input,
+    T* output,
+    const PoolImage* images,
+    int64_t num_images,
+    int64_t channels,
+    bool channels_last) {
+  using acc_t = at::opmath_type<T>;
+  auto start_index = [](int64_t o, int64_t output_size, int64_t input_size) {
+    return (o * input_size) / output_size;
+  };
+  auto end_index = [](int64_t o, int64_t output_size, int64_t input_size) {
+    return ((o + 1) * input_size + output_size - 1) / output_size;
+  };
+  const int64_t average_work =
+      _average_work(images, num_images, channels, channels_last);
+  _parallel_for_each_item(
+      images,
+      num_images,
+      channels,
+      channels_last,
+      std::max<int64_t>(average_work, 1),
+      [&](const PoolImage& image, int64_t item) {
+        const T* image_input = input + image.input_offset;
+        T* image_output = output + image.output_offset;
+        if (channels_last) {
+          const int64_t oh = item / image.output_width;
+          const int64_t ow = item % image.output_width;
+          const int64_t h_begin = start_index(oh, image.output_height, image.height);
+          const int64_t h_end = end_index(oh, image.output_height, image.height);
+          const int64_t w_begin = start_index(ow, image.output_width, image.width);
+          const int64_t w_end = end_index(ow, image.output_width, image.width);
+          std::vector<acc_t> sum(channels, acc_t(0));
+          for (int64_t h = h_begin; h < h_end; h++) {
+            for (int64_t w = w_begin; w < w_end; w++) {
+              const T* in = image_input + (h * image.width + w) * channels;
+              for (int64_t c = 0; c < channels; c++) {
+                sum[c] += static_cast<acc_t>(in[c]);
+              }
+            }
+          }
+          const acc_t count = (h_end - h_begin) * (w_end - w_begin);
+          T* out = image_output + item * channels;
+          for (int64_t c = 0; c < channels; c++) {
+            out[c] = static_cast<T>(sum[c] / count);
+          }
+          return;
+        }
+        const T* plane = image_input + item * image.height * image.width;
+        T* out = image_output + item * image.output_height * image.output_width;
+        for (int64_t oh = 0; oh < image.output_height; oh++) {
+          const int64_t h_begin = start_index(oh, image.output_height, image.height);
+          const int64_t h_end = end_index(oh, image.output_height, image.height);
+          for (int64_t ow = 0; ow < image.output_width; ow++) {
+            const int64_t w_begin = start_index(ow, image.output_width, image.width);
+            const int64_t w_end = end_index(ow, image.output_width, image.width);
+            acc_t sum = 0;
+            for (int64_t h = h_begin; h < h_end; h++) {
+              for (int64_t w = w_begin; w < w_end; w++) {
+                sum += static_cast<acc_t>(plane[h * image.width + w]);
+              }
+            }
+            const acc_t count = (h_end - h_begin) * (w_end - w_begin);
+            out[oh * image.output_width + ow] = static_cast<T>(sum / count);
+          }
+        }
+      });
+}
+
+#define INSTANTIATE_POOLING_KERNELS(T) \
+  template void max_pool2d_kernel<T>(  \
+      const T*,                        \
+      T*,                              \
+      const PoolImage*,                \
+      int64_t,                         \
+      int64_t,                         \
+      const ConvParams&,               \
+      bool);                           \
+  template void adaptive_avg_pool2d_kernel<T>( \
+      const T*, T*, const PoolImage*, int64_t, int64_t, bool);
+
+INSTANTIATE_POOLING_KERNELS(float)
+INSTANTIATE_POOLING_KERNELS(double)
+INSTANTIATE_POOLING_KERNELS(c10::BFloat16)
+#undef INSTANTIATE_POOLING_KERNELS
+
+} // namespace cpu
+} // namespace nested_tensor
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <nestedtensor/csrc/cpu/conv.h>
+#include <cstdint>
+
+namespace nested_tensor {
+namespace cpu {
+
+// An image of a ragged batch of [channels, height, width] images that is
+// stored contiguously at input_offset, either channels first or channels
+// last. Its [channels, output_height, output_width] result is stored in the
+// same memory format at output_offset.
+struct PoolImage {
+  int64_t input_offset;
+  int64_t height;
+  int64_t width;
+  int64_t output_offset;
+  int64_t output_height;
+  int64_t output_width;
+};
+
+// Computes max_pool2d of every image in parallel over the channels of all
+// images, or over the output pixels of all images if channels_last is set.
+// Padding is excluded from the max and NaN propagates, as in ATen.
+template <typename T>
+void max_pool2d_kernel(
+    const T* input,
+    T* output,
+    const PoolImage* images,
+    int64_t num_images,
+    int64_t channels,
+    const ConvParams& params,
+    bool channels_last);
+
+// Computes adaptive_avg_pool2d of every image, parallelized like
+// max_pool2d_kernel. Output pixel (oh, ow) averages the input rows
+// [floor(oh * height / output_height), ceil((oh + 1) * height / output_height))
+// and the corresponding columns. Accumulation happens in
+// at::opmath_type<T>.
+template <typename T>
+void adaptive_avg_pool2d_kernel(
+    const T* input,
+    T* output,
+    const PoolImage* images,
+    int64_t num_images,
+    int64_t channels,
+    bool channels_last);
+
+} // namespace cpu
+} // namespace nested_tensor
@@ -0,0 +1,177 @@
+#include <ATen/ATen.h>
+#include <ATen/OpMathType.h>
+#include <ATen/Parallel.h>
+#include <nestedtensor/csrc/cpu/reduce.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace nested_tensor {
+namespace cpu {
+
+namespace {
+
+template <typename T>
+inline bool _isnan(T value) {
+  return std::isnan(static_cast<at::opmath_type<T>>(value));
+}
+
+} // namespace
+
+std::vector<ReduceSegment> make_reduce_segments(
+    const int64_t* offsets,
+    const int64_t* sizes,
+    int64_t degree,
+    int64_t tensor_dim,
+    int64_t dim) {
+  std::vector<ReduceSegment> segments(degree);
+  int64_t output_offset = 0;
+  for (int64_t i = 0; i < degree; i++) {
+    const int64_t* size = sizes + i * tensor_dim;
+    int64_t outer = 1;
+    int64_t inner = 1;
+    for (int64_t j = 0; j < dim; j++) {
+      outer *= size[j];
+    }
+    for (int64_t j = dim + 1; j < tensor_dim; j++) {
+      inner *= size[j];
+    }
+    segments[i] = {offsets[i], output_offset, outer, size[dim], inner};
+    output_offset += outer * inner;
+  }
+  return segments;
+}
+
+template <typename T>
+void segmented_sum_kernel(
+    const T* input,
+    T* output,
+    const ReduceSegment* segments,
+    int64_t num_segments,
+    bool mean) {
+  using acc_t = at::opmath_type<T>;
+  parallel_for_each_outer<acc_t>(
+      segments,
+      num_segments,
+      1,
+      [&](const ReduceSegment& segment, int64_t o, acc_t* acc) {
+        const int64_t size = segment.size;
+        const int64_t inner = segment.inner;
+        const T* block = input + segment.input_offset + o * size * inner;
+        T* out = output + segment.output_offset + o * inner;
+        const acc_t scale = mean ? acc_t(1) / static_cast<acc_t>(size)
+                                 : acc_t(1);
+        if (inner == 1) {
+          acc_t sum = 0;
+          for (int64_t r = 0; r < size; r++) {
+            sum += static_cast<acc_t>(block[r]);
+          }
+          out[0] = static_cast<T>(sum * scale);
+          return;
+        }
+        std::fill(acc, acc + inner, acc_t(0));
+        for (int64_t r = 0; r < size; r++) {
+          const T* row = block + r * inner;
+          for (int64_t j = 0; j < inner; j++) {
+            acc[j] += static_cast<acc_t>(row[j]);
+          }
+        }
+        for (int64_t j = 0; j < inner; j++) {
+          out[j] = static_cast<T>(acc[j] * scale);
+        }
+      });
+}
+
+template <typename T>
+void segmented_max_kernel(
+    const T* input,
+    T* values,
+    int64_t* indices,
+    const ReduceSegment* segments,
+    int64_t num_segments) {
+  parallel_for_each_outer<T>(
+      segments,
+      num_segments,
+      0,
+      [&](const ReduceSegment& segment, int64_t o, T* /* unused */) {
+        const int64_t size = segment.size;
+        const int64_t inner = segment.inner;
+        const T* block = input + segment.input_offset + o * size * inner;
+        T* out_values = values + segment.output_offset + o * inner;
+        int64_t* out_indices = indices + segment.output_offset + o * inner;
+        std::copy(block, block + inner, out_values);
+        std::fill(out_indices, out_indices + inner, int64_t(0));
+        for (int64_t r = 1; r < size; r++) {
+          const T* row = block + r * inner;
+          for (int64_t j = 0; j < inner; j++) {
+            if (!_isnan(out_values[j]) &&
+                (_isnan(row[j]) || row[j] > out_values[j])) {
+              out_values[j] = row[j];
+              out_indices[j] = r;
+            }
+          }
+        }
+      });
+}
+
+template <typename T>
+void segmented_var_kernel(
+    const T* input,
+    T* output,
+    const ReduceSegment* segments,
+    int64_t num_segments,
+    bool unbiased) {
+  using acc_t = at::opmath_type<T>;
+  parallel_for_each_outer<acc_t>(
+      segments,
+      num_segments,
+      2,
+      [&](const ReduceSegment& segment, int64_t o, acc_t* buffer) {
+        const int64_t size = segment.size;
+        const int64_t inner = segment.inner;
+        const T* block = input + segment.input_offset + o * size * inner;
+        T* out = output + segment.output_offset + o * inner;
+        acc_t* mean = buffer;
+        acc_t* m2 = buffer + inner;
+        std::fill(mean, mean + inner, acc_t(0));
+        std::fill(m2, m2 + inner, acc_t(0));
+        for (int64_t r = 0; r < size; r++) {
+          const T* row = block + r * inner;
+          for (int64_t j = 0; j < inner; j++) {
+            mean[j] += static_cast<acc_t>(row[j]);
+          }
+        }
+        const acc_t inv_size = acc_t(1) / static_cast<acc_t>(size);
+        for (int64_t j = 0; j < inner; j++) {
+          mean[j] *= inv_size;
+        }
+        for (int64_t r = 0; r < size; r++) {
+          const T* row = block + r * inner;
+          for (int64_t j = 0; j < inner; j++) {
+            const acc_t delta = static_cast<acc_t>(row[j]) - mean[j];
+            m2[j] += delta * delta;
+          }
+        }
+        const acc_t divisor = static_cast<acc_t>(size - (unbiased ? 1 : 0));
+        for (int64_t j = 0; j < inner; j++) {
+          out[j] = static_cast<T>(m2[j] / divisor);
+        }
+      });
+}
+
+#define INSTANTIATE_REDUCE_KERNELS(T)                                     \
+  template void segmented_sum_kernel<T>(                                  \
+      const T*, T*, const ReduceSegment*, int64_t, bool);                 \
+  template void segmented_max_kernel<T>(                                  \
+      const T*, T*, int64_t*, const ReduceSegment*, int64_t);             \
+  template void segmented_var_kernel<T>(                                  \
+      const T*, T*, const ReduceSegment*, int64_t, bool);
+
+INSTANTIATE_REDUCE_KERNELS(float)
+INSTANTIATE_REDUCE_KERNELS(double)
+INSTANTIATE_REDUCE_KERNELS(c10::Half)
+INSTANTIATE_REDUCE_KERNELS(c10::BFloat16)
+#undef INSTANTIATE_REDUCE_KERNELS
+
+} // namespace cpu
+} // namespace nested_tensor
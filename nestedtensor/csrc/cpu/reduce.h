@@ -0,0 +1,107 @@
+#pragma once
+
+#include <ATen/Parallel.h>
+#include <nestedtensor/csrc/cpu/parallel.h>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace nested_tensor {
+namespace cpu {
+
+// One constituent of a segmented reduction. The constituent is viewed as a
+// contiguous [outer, size, inner] block starting at input_offset and is
+// reduced along its middle dimension into a contiguous [outer, inner] block
+// starting at output_offset.
+struct ReduceSegment {
+  int64_t input_offset;
+  int64_t output_offset;
+  int64_t outer;
+  int64_t size;
+  int64_t inner;
+};
+
+// Builds the segments for reducing packed constituents along tensor
+// dimension dim. offsets holds the start of each constituent in the buffer
+// and sizes is a [degree, tensor_dim] matrix of their shapes. The outputs of
+// the segments are packed one after the other.
+std::vector<ReduceSegment> make_reduce_segments(
+    const int64_t* offsets,
+    const int64_t* sizes,
+    int64_t degree,
+    int64_t tensor_dim,
+    int64_t dim);
+
+// Calls fn(segment, o, buffer) for every outer index o of every segment in
+// parallel. buffer is scratch space of at least buffer_rows * segment.inner
+// values that is reused across calls on the same thread.
+template <typename acc_t, typename F>
+inline void parallel_for_each_outer(
+    const ReduceSegment* segments,
+    int64_t num_segments,
+    int64_t buffer_rows,
+    const F& fn) {
+  std::vector<int64_t> outer_offsets(num_segments + 1, 0);
+  int64_t numel = 0;
+  for (int64_t i = 0; i < num_segments; i++) {
+    outer_offsets[i + 1] = outer_offsets[i] + segments[i].outer;
+    numel += segments[i].outer * segments[i].size * segments[i].inner;
+  }
+  const int64_t total_outer = outer_offsets[num_segments];
+  if (total_outer == 0) {
+    return;
+  }
+  const int64_t grain_size = std::max<int64_t>(
+      at::internal::GRAIN_SIZE * total_outer / std::max<int64_t>(numel, 1),
+      1);
+  at::parallel_for(0, total_outer, grain_size, [&](int64_t begin, int64_t end) {
+    std::vector<acc_t> buffer;
+    for_each_segment_index(
+        outer_offsets.data(),
+        num_segments,
+        begin,
+        end,
+        [&](int64_t i, int64_t o) {
+          const ReduceSegment& segment = segments[i];
+          const int64_t buffer_size = buffer_rows * segment.inner;
+          if (static_cast<int64_t>(buffer.size()) < buffer_size) {
+            buffer.resize(buffer_size);
+          }
+          fn(segment, o, buffer.data());
+        });
+  });
+}
+
+// Sums each segment, or averages it if mean is set. Accumulation happens in
+// at::opmath_type<T>.
+template <typename T>
+void segmented_sum_kernel(
+    const T* input,
+    T* output,
+    const ReduceSegment* segments,
+    int64_t num_segments,
+    bool mean);
+
+// Computes the maximum of each segment and the index of its first
+// occurrence along the reduced dimension. NaN is propagated like in at::max.
+// Every segment must have a nonzero size.
+template <typename T>
+void segmented_max_kernel(
+    const T* input,
+    T* values,
+    int64_t* indices,
+    const ReduceSegment* segments,
+    int64_t num_segments);
+
+// Computes the variance of each segment in two passes, first the mean and
+// then the sum of squared deviations from it.
+template <typename T>
+void segmented_var_kernel(
+    const T* input,
+    T* output,
+    const ReduceSegment* segments,
+    int64_t num_segments,
+    bool unbiased);
+
+} // namespace cpu
+} // namespace nested_tensor
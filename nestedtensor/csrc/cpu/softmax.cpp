@@ -0,0 +1,140 @@
+#include <ATen/ATen.h>
+#include <ATen/OpMathType.h>
+#include <ATen/Parallel.h>
+#include <nestedtensor/csrc/cpu/softmax.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace nested_tensor {
+namespace cpu {
+
+// Each row is processed in three passes over a buffer of opmath values:
+// scale and take the max, exponentiate and sum, normalize. The passes are
+// kept free of branches so that the compiler can vectorize them.
+template <typename T>
+void scaled_softmax_kernel(
+    T* data,
+    int64_t rows,
+    int64_t length,
+    double scale) {
+  using acc_t = at::opmath_type<T>;
+  const acc_t scale_ = static_cast<acc_t>(scale);
+  const acc_t neg_inf = -std::numeric_limits<acc_t>::infinity();
+  const int64_t grain_size = std::max<int64_t>(
+      at::internal::GRAIN_SIZE / std::max<int64_t>(length, 1), 1);
+  at::parallel_for(0, rows, grain_size, [&](int64_t begin, int64_t end) {
+    std::vector<acc_t> buffer(length);
+    acc_t* values = buffer.data();
+    for (int64_t row = begin; row < end; row++) {
+      T* row_data = data + row * length;
+      acc_t max_value = neg_inf;
+      for (int64_t j = 0; j < length; j++) {
+        values[j] = static_cast<acc_t>(row_data[j]) * scale_;
+        max_value = std::max(max_value, values[j]);
+      }
+      acc_t sum = 0;
+      for (int64_t j = 0; j < length; j++) {
+        values[j] = std::exp(values[j] - max_value);
+        sum += values[j];
+      }
+      const acc_t inv_sum = acc_t(1) / sum;
+      for (int64_t j = 0; j < length; j++) {
+        row_data[j] = static_cast<T>(values[j] * inv_sum);
+      }
+    }
+  });
+}
+
+// Every outer index of a segment is processed in three passes over the
+// input: the max and the sum of exponentials are accumulated for all inner
+// positions at once, so that the loops run over contiguous memory, before
+// the output is written.
+template <typename T>
+void segmented_softmax_kernel(
+    const T* input,
+    const T* mask,
+    T* output,
+    const ReduceSegment* segments,
+    int64_t num_segments,
+    double scale,
+    bool log) {
+  using acc_t = at::opmath_type<T>;
+  const acc_t scale_ = static_cast<acc_t>(scale);
+  const acc_t neg_inf = -std::numeric_limits<acc_t>::infinity();
+  parallel_for_each_outer<acc_t>(
+      segments,
+      num_segments,
+      2,
+      [&](const ReduceSegment& segment, int64_t o, acc_t* buffer) {
+        const int64_t numel = segment.size * segment.inner;
+        const int64_t inner = segment.inner;
+        const int64_t offset = segment.input_offset + o * numel;
+        const T* block = input + offset;
+        const T* block_mask = mask == nullptr ? nullptr : mask + offset;
+        T* block_output = output + offset;
+        auto value = [&](int64_t k) {
+          acc_t v = static_cast<acc_t>(block[k]) * scale_;
+          if (block_mask != nullptr) {
+            v += static_cast<acc_t>(block_mask[k]);
+          }
+          return v;
+        };
+        acc_t* max_value = buffer;
+        acc_t* sum = buffer + inner;
+        std::fill(max_value, max_value + inner, neg_inf);
+        std::fill(sum, sum + inner, acc_t(0));
+        for (int64_t k = 0; k < numel; k += inner) {
+          for (int64_t j = 0; j < inner; j++) {
+            max_value[j] = std::max(max_value[j], value(k + j));
+          }
+        }
+        for (int64_t k = 0; k < numel; k += inner) {
+          for (int64_t j = 0; j < inner; j++) {
+            sum[j] += std::exp(value(k + j) - max_value[j]);
+          }
+        }
+        if (log) {
+          for (int64_t j = 0; j < inner; j++) {
+            sum[j] = max_value[j] + std::log(sum[j]);
+          }
+          for (int64_t k = 0; k < numel; k += inner) {
+            for (int64_t j = 0; j < inner; j++) {
+              block_output[k + j] = static_cast<T>(value(k + j) - sum[j]);
+            }
+          }
+          return;
+        }
+        for (int64_t j = 0; j < inner; j++) {
+          sum[j] = acc_t(1) / sum[j];
+        }
+        for (int64_t k = 0; k < numel; k += inner) {
+          for (int64_t j = 0; j < inner; j++) {
+            block_output[k + j] =
+                static_cast<T>(std::exp(value(k + j) - max_value[j]) * sum[j]);
+          }
+        }
+      });
+}
+
+#define INSTANTIATE_SOFTMAX_KERNELS(T)                     \
+  template void scaled_softmax_kernel<T>(                \
+      T*, int64_t, int64_t, double);                     \
+  template void segmented_softmax_kernel<T>(             \
+      const T*,                                          \
+      const T*,                                          \
+      T*,                                                \
+      const ReduceSegment*,                              \
+      int64_t,                                           \
+      double,                                            \
+      bool);
+
+INSTANTIATE_SOFTMAX_KERNELS(float)
+INSTANTIATE_SOFTMAX_KERNELS(double)
+INSTANTIATE_SOFTMAX_KERNELS(c10::Half)
+INSTANTIATE_SOFTMAX_KERNELS(c10::BFloat16)
+#undef INSTANTIATE_SOFTMAX_KERNELS
+
+} // namespace cpu
+} // namespace nested_tensor
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <nestedtensor/csrc/cpu/reduce.h>
+#include <cstdint>
+
+namespace nested_tensor {
+namespace cpu {
+
+// Computes softmax(scale * x) in place over each row of a contiguous
+// [rows, length] matrix. Accumulation happens in at::opmath_type<T>.
+template <typename T>
+void scaled_softmax_kernel(
+    T* data,
+    int64_t rows,
+    int64_t length,
+    double scale);
+
+// Computes softmax(scale * x + mask) along the middle dimension of every
+// segment, see ReduceSegment. The result is written to output at the input
+// offsets, so output_offset is ignored and output may alias input. mask is
+// an additive mask with the same layout as input and may be null. If log is
+// set, log_softmax is computed instead. Accumulation happens in
+// at::opmath_type<T>.
+template <typename T>
+void segmented_softmax_kernel(
+    const T* input,
+    const T* mask,
+    T* output,
+    const ReduceSegment* segments,
+    int64_t num_segments,
+    double scale,
+    bool log);
+
+} // namespace cpu
+} // namespace nested_tensor
@@ -0,0 +1,77 @@
+#include <ATen/ATen.h>
+#include <ATen/Parallel.h>
+#include <nestedtensor/csrc/cpu/parallel.h>
+#include <nestedtensor/csrc/cpu/transpose.h>
+#include <algorithm>
+
+namespace nested_tensor {
+namespace cpu {
+
+template <typename T>
+void transpose_kernel(
+    const T* input,
+    T* output,
+    const int64_t* offsets,
+    const int64_t* block_offsets,
+    int64_t num_matrices,
+    int64_t regular,
+    bool rows_regular,
+    int64_t block_size) {
+  const int64_t num_blocks = block_offsets[num_matrices];
+  if (num_blocks == 0 || regular == 0) {
+    return;
+  }
+  const int64_t grain_size = std::max<int64_t>(
+      at::internal::GRAIN_SIZE / (block_size * block_size), 1);
+  at::parallel_for(0, num_blocks, grain_size, [&](int64_t begin, int64_t end) {
+    for_each_segment_index(
+        block_offsets,
+        num_matrices,
+        begin,
+        end,
+        [&](int64_t i, int64_t local) {
+          const int64_t numel = offsets[i + 1] - offsets[i];
+          const int64_t rows = rows_regular ? regular : numel / regular;
+          const int64_t cols = rows_regular ? numel / regular : regular;
+          const int64_t col_blocks = (cols + block_size - 1) / block_size;
+          const int64_t row_begin = (local / col_blocks) * block_size;
+          const int64_t col_begin = (local % col_blocks) * block_size;
+          const int64_t row_end = std::min(row_begin + block_size, rows);
+          const int64_t col_end = std::min(col_begin + block_size, cols);
+          const T* matrix_input = input + offsets[i];
+          T* matrix_output = output + offsets[i];
+          for (int64_t c = col_begin; c < col_end; c++) {
+            T* output_row = matrix_output + c * rows;
+            for (int64_t r = row_begin; r < row_end; r++) {
+              output_row[r] = matrix_input[r * cols + c];
+            }
+          }
+        });
+  });
+}
+
+#define INSTANTIATE_TRANSPOSE_KERNELS(T) \
+  template void transpose_kernel<T>(     \
+      const T*,                          \
+      T*,                                \
+      const int64_t*,                    \
+      const int64_t*,                    \
+      int64_t,                           \
+      int64_t,                           \
+      bool,                              \
+      int64_t);
+
+INSTANTIATE_TRANSPOSE_KERNELS(uint8_t)
+INSTANTIATE_TRANSPOSE_KERNELS(int8_t)
+INSTANTIATE_TRANSPOSE_KERNELS(int16_t)
+INSTANTIATE_TRANSPOSE_KERNELS(int)
+INSTANTIATE_TRANSPOSE_KERNELS(int64_t)
+INSTANTIATE_TRANSPOSE_KERNELS(float)
+INSTANTIATE_TRANSPOSE_KERNELS(double)
+INSTANTIATE_TRANSPOSE_KERNELS(bool)
+INSTANTIATE_TRANSPOSE_KERNELS(c10::Half)
+INSTANTIATE_TRANSPOSE_KERNELS(c10::BFloat16)
+#undef INSTANTIATE_TRANSPOSE_KERNELS
+
+} // namespace cpu
+} // namespace nested_tensor
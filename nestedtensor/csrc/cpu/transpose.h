@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+
+namespace nested_tensor {
+namespace cpu {
+
+// Transposes a batch of packed row-major matrices. Matrix i starts at
+// offsets[i] in both input and output and has offsets[i + 1] - offsets[i]
+// elements. If rows_regular is set every matrix has regular rows, otherwise
+// regular columns, and the other dimension follows from its number of
+// elements. Each matrix is split into block_size x block_size tiles, of
+// which matrix i owns [block_offsets[i], block_offsets[i + 1]), as computed
+// by _create_offsets. The tiles of all matrices are transposed in parallel,
+// so that both the reads and the writes of a tile stay in cache.
+template <typename T>
+void transpose_kernel(
+    const T* input,
+    T* output,
+    const int64_t* offsets,
+    const int64_t* block_offsets,
+    int64_t num_matrices,
+    int64_t regular,
+    bool rows_regular,
+    int64_t block_size);
+
+} // namespace cpu
+} // namespace nested_tensor
@@ -4,6 +4,7 @@
 #include <nestedtensor/csrc/utils/nested_node.h>
 #include <torch/csrc/jit/python/pybind_utils.h>
 #include <torch/extension.h>
+#include <algorithm>
 
 namespace py = pybind11;
 
@@ -188,6 +189,29 @@ TensorNode py_to_nested_tensor(const py::object& py_obj) {
   TORCH_CHECK(false, "Currently only supporting a flat sequence of Tensors.");
 }
 
+// Converts buffer to the given dtype and device and pins it if requested,
+// copying at most once. A pinned result is allocated directly rather than
+// copied into pinned memory after the conversion.
+at::Tensor _convert_buffer(
+    at::Tensor buffer,
+    at::ScalarType dtype,
+    at::Device device,
+    bool pin_memory) {
+  if (!pin_memory) {
+    return buffer.to(device, dtype);
+  }
+  TORCH_CHECK(
+      device.is_cpu(), "Can only pin memory of a NestedTensor on the CPU.");
+  if (buffer.is_cpu() && buffer.scalar_type() == dtype && buffer.is_pinned()) {
+    return buffer;
+  }
+  at::Tensor result = at::empty(
+      {buffer.numel()},
+      at::TensorOptions().dtype(dtype).device(device).pinned_memory(true));
+  result.copy_(buffer.reshape({-1}));
+  return result;
+}
+
 at::Tensor nested_tensor_impl(
     py::sequence list,
     py::object dtype_,
@@ -208,11 +232,8 @@ at::Tensor nested_tensor_impl(
     }
   }
   Tensor result = wrap_tensor_node(std::move(ivalue_structure));
-  Tensor buffer = get_buffer(result);
-  buffer = buffer.to(device, dtype);
-  if (pin_memory) {
-    buffer = buffer.pin_memory();
-  }
+  Tensor buffer =
+      _convert_buffer(get_buffer(result), dtype, device, pin_memory);
   result = wrap_buffer(std::move(buffer), get_efficient_nested_size(result));
   if (channels_last) {
     result = NestedTensor_contiguous(result, c10::MemoryFormat::ChannelsLast);
@@ -221,5 +242,130 @@ at::Tensor nested_tensor_impl(
   return result;
 }
 
+at::Tensor nested_tensor_from_buffer(
+    at::Tensor buffer,
+    at::Tensor sizes,
+    c10::optional<at::Tensor> strides,
+    py::object dtype_,
+    py::object device_,
+    bool requires_grad,
+    bool pin_memory) {
+  if (requires_grad) {
+    throw std::runtime_error(
+        "This version of nestedtensor currently does not support autograd. Please open an issue on https://github.com/pytorch/nestedtensor if you need this.");
+  }
+  TORCH_CHECK(
+      !is_nested_tensor_impl(buffer), "Given buffer must be a regular Tensor.");
+  TORCH_CHECK(
+      !is_nested_tensor_impl(sizes), "Given sizes must be a regular Tensor.");
+  TORCH_CHECK(
+      sizes.dim() == 1 || sizes.dim() == 2,
+      "Given sizes must be a vector of lengths or a matrix with one row of sizes per constituent, but got ",
+      sizes.dim(),
+      " dimensions.");
+  TORCH_CHECK(
+      !at::isFloatingType(sizes.scalar_type()) &&
+          !at::isComplexType(sizes.scalar_type()),
+      "Given sizes must be of integral type.");
+  auto dtype = dtype_.is_none() ? buffer.scalar_type()
+                                : toTypeInferredIValue(dtype_).toScalarType();
+  auto device = device_.is_none() ? buffer.device()
+                                  : toTypeInferredIValue(device_).toDevice();
+  // The metadata is owned by the result, so it is always copied.
+  at::Tensor sizes_ = sizes.to(at::kCPU, at::kLong, false, true).contiguous();
+  if (sizes.dim() == 1) {
+    // A vector of lengths along the first dimension of the buffer. All other
+    // dimensions are shared by the constituents.
+    TORCH_CHECK(
+        !strides, "Strides can only be given together with a matrix of sizes.");
+    TORCH_CHECK(
+        buffer.dim() > 0, "Given buffer must have at least one dimension.");
+    at::Tensor lengths = sizes_;
+    const int64_t* lengths_ptr = lengths.data_ptr<int64_t>();
+    sizes_ = at::empty({lengths.numel(), buffer.dim()}, at::kLong);
+    int64_t* sizes_ptr = sizes_.data_ptr<int64_t>();
+    for (int64_t i = 0; i < lengths.numel(); i++) {
+      sizes_ptr[i * buffer.dim()] = lengths_ptr[i];
+      for (int64_t j = 1; j < buffer.dim(); j++) {
+        sizes_ptr[i * buffer.dim() + j] = buffer.size(j);
+      }
+    }
+  }
+  const int64_t degree = sizes_.size(0);
+  const int64_t tensor_dim = sizes_.size(1);
+  at::Tensor strides_;
+  if (strides) {
+    TORCH_CHECK(
+        !is_nested_tensor_impl(*strides),
+        "Given strides must be a regular Tensor.");
+    TORCH_CHECK(
+        strides->sizes() == sizes_.sizes(),
+        "Given strides of shape ",
+        strides->sizes(),
+        " don't match sizes of shape ",
+        sizes_.sizes(),
+        ".");
+    strides_ = strides->to(at::kCPU, at::kLong, false, true).contiguous();
+  }
+  // Validate the sizes and strides in a single pass over the tables. Given
+  // strides must lay out each constituent densely, without overlap, so that
+  // the constituents occupy consecutive ranges of the buffer and the result
+  // is packed whenever it is contiguous.
+  buffer = buffer.reshape({-1});
+  const int64_t* sizes_ptr = sizes_.data_ptr<int64_t>();
+  const int64_t* strides_ptr =
+      strides_.defined() ? strides_.data_ptr<int64_t>() : nullptr;
+  std::vector<std::pair<int64_t, int64_t>> dims;
+  dims.reserve(tensor_dim);
+  int64_t offset = 0;
+  for (int64_t i = 0; i < degree; i++) {
+    int64_t numel = 1;
+    dims.clear();
+    for (int64_t j = 0; j < tensor_dim; j++) {
+      const int64_t size = sizes_ptr[i * tensor_dim + j];
+      TORCH_CHECK(
+          size >= 0,
+          "Constituent ", i, " has negative size ", size, " in dimension ", j, ".");
+      numel = numel * size;
+      if (strides_ptr && size > 1) {
+        dims.emplace_back(strides_ptr[i * tensor_dim + j], size);
+      }
+    }
+    if (strides_ptr && numel > 0) {
+      std::sort(dims.begin(), dims.end());
+      int64_t dense_stride = 1;
+      for (const auto& dim : dims) {
+        TORCH_CHECK(
+            dim.first == dense_stride,
+            "Given strides of constituent ", i,
+            " are not dense and non-overlapping.");
+        dense_stride = dense_stride * dim.second;
+      }
+    }
+    offset = offset + numel;
+  }
+  if (strides_ptr) {
+    TORCH_CHECK(
+        offset <= buffer.numel(),
+        "Given buffer of numel ", buffer.numel(),
+        " is too small for sizes of numel ", offset, ".");
+    buffer = buffer.narrow(0, 0, offset);
+  } else {
+    TORCH_CHECK(
+        offset == buffer.numel(),
+        "Given buffer of numel ", buffer.numel(),
+        " doesn't match sizes of numel ", offset, ".");
+  }
+  buffer = _convert_buffer(std::move(buffer), dtype, device, pin_memory);
+  EfficientSizeNode nested_size(degree, sizes_);
+  if (strides_.defined()) {
+    return wrap_buffer(
+        std::move(buffer),
+        nested_size,
+        EfficientSizeNode(degree, strides_));
+  }
+  return wrap_buffer(std::move(buffer), nested_size);
+}
+
 } // namespace nested_tensor
 } // namespace torch
@@ -15,5 +15,17 @@ at::Tensor nested_tensor_impl(
     bool pin_memory,
     bool channels_last);
 
+// Wraps a flat buffer as a NestedTensor given per-constituent sizes and
+// optionally strides. Doesn't copy the buffer unless it isn't contiguous or
+// it is converted to a different dtype or device, or pinned.
+at::Tensor nested_tensor_from_buffer(
+    at::Tensor buffer,
+    at::Tensor sizes,
+    c10::optional<at::Tensor> strides,
+    pybind11::object dtype,
+    pybind11::object device,
+    bool requires_grad,
+    bool pin_memory);
+
 } // namespace nested_tensor
 } // namespace torch
@@ -1,6 +1,10 @@
 #ifdef WITH_CUDA
 #include <nestedtensor/csrc/cuda/layernorm.h>
 #endif
+#include <ATen/TensorUtils.h>
+#include <c10/util/accumulate.h>
+#include <nestedtensor/csrc/cpu/cat.h>
+#include <nestedtensor/csrc/cpu/layernorm.h>
 #include <nestedtensor/csrc/nested_tensor_impl.h>
 #include <nestedtensor/csrc/utils/nested_node_functions.h>
 #include <torch/extension.h>
@@ -62,6 +66,82 @@ Tensor NestedTensor_embedding(
       indices);
 }
 
+namespace {
+
+// Normalizes the packed buffer of a contiguous CPU NestedTensor in one pass,
+// viewing it as [rows, hidden]. residual must be a NestedTensor of the same
+// nested size as input, while bias, weight and layer_bias are dense [hidden]
+// Tensors. Returns an undefined Tensor if the inputs don't qualify, in which
+// case callers fall back to per-constituent calls.
+Tensor _layer_norm_cpu(
+    const Tensor& input,
+    const c10::optional<Tensor>& residual,
+    const c10::optional<Tensor>& bias,
+    const c10::optional<Tensor>& weight,
+    const c10::optional<Tensor>& layer_bias,
+    int64_t hidden,
+    double eps) {
+  Tensor buffer = get_buffer(input);
+  const ScalarType dtype = buffer.scalar_type();
+  if (!buffer.is_cpu() || !get_is_contiguous(input) ||
+      !(dtype == kFloat || dtype == kDouble || dtype == kHalf ||
+        dtype == kBFloat16)) {
+    return Tensor();
+  }
+  auto usable = [&dtype, &hidden](const c10::optional<Tensor>& t) {
+    return !t ||
+        (!is_nested_tensor_impl(*t) && t->is_cpu() &&
+         t->scalar_type() == dtype && t->numel() == hidden);
+  };
+  if (!usable(bias) || !usable(weight) || !usable(layer_bias)) {
+    return Tensor();
+  }
+  Tensor residual_buffer;
+  if (residual) {
+    if (!is_nested_tensor_impl(*residual) ||
+        !get_is_contiguous(*residual) ||
+        !efficient_size_matches(
+            get_efficient_nested_size(input),
+            get_efficient_nested_size(*residual))) {
+      return Tensor();
+    }
+    residual_buffer = get_buffer(*residual);
+    if (!residual_buffer.is_cpu() || residual_buffer.scalar_type() != dtype) {
+      return Tensor();
+    }
+  }
+  auto contiguous_or_undefined = [](const c10::optional<Tensor>& t) {
+    return t ? t->contiguous() : Tensor();
+  };
+  Tensor bias_ = contiguous_or_undefined(bias);
+  Tensor weight_ = contiguous_or_undefined(weight);
+  Tensor layer_bias_ = contiguous_or_undefined(layer_bias);
+  Tensor output = empty_buffer(buffer.numel(), buffer.options());
+  const int64_t rows = hidden == 0 ? 0 : buffer.numel() / hidden;
+  AT_DISPATCH_FLOATING_TYPES_AND2(
+      kHalf, kBFloat16, dtype, "NestedTensor_layer_norm_cpu", [&] {
+        auto ptr_or_null = [](const Tensor& t) -> const scalar_t* {
+          return t.defined() ? t.data_ptr<scalar_t>() : nullptr;
+        };
+        ::nested_tensor::cpu::layer_norm_kernel<scalar_t>(
+            buffer.data_ptr<scalar_t>(),
+            ptr_or_null(residual_buffer),
+            ptr_or_null(bias_),
+            ptr_or_null(weight_),
+            ptr_or_null(layer_bias_),
+            output.data_ptr<scalar_t>(),
+            rows,
+            hidden,
+            eps);
+      });
+  return wrap_buffer(
+      std::move(output),
+      get_efficient_nested_size(input),
+      get_efficient_nested_stride(input));
+}
+
+} // namespace
+
 Tensor NestedTensor_layer_norm(
     const Tensor& input,
     IntArrayRef normalized_shape,
@@ -84,7 +164,15 @@ Tensor NestedTensor_layer_norm(
       "] does not match the size of the last dimension (",
       *input_opt_sizes[get_dim(input) - 1],
       ") of input.");
+  TORCH_CHECK(
+      (weight && bias) || (!weight && !bias),
+      "Either both weight and bias are used or not.");
 
+  Tensor result = _layer_norm_cpu(
+      input, c10::nullopt, c10::nullopt, weight, bias, normalized_shape[0], eps);
+  if (result.defined()) {
+    return result;
+  }
   if (weight && bias) {
 #ifdef WITH_CUDA
     if (weight->is_cuda() && bias->is_cuda()) {
@@ -100,7 +188,6 @@ Tensor NestedTensor_layer_norm(
         *weight,
         *bias);
   }
-  TORCH_CHECK(!weight && !bias, "Either both weight and bias are used or not.");
   return map_nested_tensor(
       [normalized_shape, eps](const at::Tensor t) {
         return at::layer_norm(
@@ -109,6 +196,41 @@ Tensor NestedTensor_layer_norm(
       input);
 }
 
+// Computes layer_norm(input + residual + bias) over the last dimension,
+// fusing the residual connection of a transformer block into the
+// normalization that follows it. This mirrors fastertransformer's
+// add_bias_input_layernorm.
+Tensor NestedTensor_add_bias_layer_norm(
+    const Tensor& input,
+    const Tensor& residual,
+    const c10::optional<Tensor>& bias,
+    const c10::optional<Tensor>& weight,
+    const c10::optional<Tensor>& layer_bias,
+    double eps) {
+  TORCH_CHECK(
+      is_nested_tensor_impl(input, residual),
+      "Expected input and residual to be NestedTensors.");
+  TORCH_CHECK(
+      (weight && layer_bias) || (!weight && !layer_bias),
+      "Either both weight and layer_bias are used or not.");
+  auto input_opt_sizes = get_opt_sizes(input);
+  TORCH_CHECK(
+      input_opt_sizes[get_dim(input) - 1],
+      "Cannot normalize across irregular dimension ",
+      std::to_string(get_dim(input) - 1));
+  const int64_t hidden = *input_opt_sizes[get_dim(input) - 1];
+  Tensor result =
+      _layer_norm_cpu(input, residual, bias, weight, layer_bias, hidden, eps);
+  if (result.defined()) {
+    return result;
+  }
+  Tensor sum = at::add(input, residual);
+  if (bias) {
+    sum = at::add(sum, *bias);
+  }
+  return at::layer_norm(sum, {hidden}, weight, layer_bias, eps, true);
+}
+
 Tensor NestedTensor_all(const Tensor& self) {
   auto self_impl = get_nested_tensor_impl(self);
   if (get_numel(self) == 0) {
@@ -149,14 +271,6 @@ Tensor NestedTensor_any(const Tensor& self) {
   return gathered.any();
 }
 
-Tensor NestedTensor__log_softmax(
-    const Tensor& self,
-    const int64_t dim_,
-    const bool half_to_float) {
-  return map_nested_tensor(
-      [&](Tensor a) { return at::_log_softmax(a, dim_, half_to_float); }, self);
-}
-
 Tensor NestedTensor_pin_memory(const Tensor& self, c10::optional<Device> device) {
   return map_nested_tensor(
       [&device](Tensor tensor) { return at::native::pin_memory(tensor, device); }, self);
@@ -174,6 +288,35 @@ Tensor NestedTensor_flatten(
       start_dim >= nested_dim, "Cannot flatten nested dimension ", start_dim);
   TORCH_CHECK(
       end_dim >= nested_dim, "Cannot flatten nested dimension ", end_dim);
+  if (start_dim == end_dim) {
+    return self;
+  }
+  Tensor result = view_nested_tensor(
+      [start_dim, end_dim, nested_dim](
+          const int64_t* size,
+          const int64_t* stride,
+          int64_t dim,
+          int64_t* new_size,
+          int64_t* new_stride) {
+        IntArrayRef size_ref(size, dim);
+        std::vector<int64_t> shape(size, size + start_dim - nested_dim);
+        shape.push_back(c10::multiply_integers(
+            size_ref.slice(start_dim - nested_dim, end_dim - start_dim + 1)));
+        shape.insert(shape.end(), size + end_dim - nested_dim + 1, size + dim);
+        auto strides = at::detail::computeStride(
+            size_ref, IntArrayRef(stride, dim), shape);
+        if (!strides) {
+          return false;
+        }
+        std::copy(shape.begin(), shape.end(), new_size);
+        std::copy(strides->begin(), strides->end(), new_stride);
+        return true;
+      },
+      self,
+      get_dim(self) - nested_dim - (end_dim - start_dim));
+  if (result.defined()) {
+    return result;
+  }
   // XXX: Write test that checks for flatten autograd support.
   return map_nested_tensor(
       [start_dim, end_dim, nested_dim](at::Tensor tensor) {
@@ -183,6 +326,162 @@ Tensor NestedTensor_flatten(
       self);
 }
 
+namespace {
+
+// Whether all tensors are NestedTensors whose buffers share dtype and
+// device, so that they can be combined without type promotion.
+bool _buffers_match(TensorList tensors) {
+  for (const Tensor& tensor : tensors) {
+    if (!is_nested_tensor_impl(tensor)) {
+      return false;
+    }
+    const Tensor& buffer = get_buffer(tensor);
+    const Tensor& buffer0 = get_buffer(tensors[0]);
+    if (buffer.scalar_type() != buffer0.scalar_type() ||
+        buffer.device() != buffer0.device()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Concatenates NestedTensors along the nested dimension by concatenating
+// their buffers and their tables of nested sizes and strides. Inputs that
+// aren't packed are made contiguous first.
+Tensor _cat_nested_dim(TensorList tensors) {
+  if (!_buffers_match(tensors)) {
+    return Tensor();
+  }
+  std::vector<Tensor> buffers;
+  std::vector<Tensor> sizes;
+  std::vector<Tensor> strides;
+  bool contiguous = true;
+  int64_t degree = 0;
+  int64_t numel = 0;
+  for (Tensor tensor : tensors) {
+    if (get_efficient_nested_size(tensor).degree() == 0) {
+      continue;
+    }
+    if (!get_is_packed(tensor)) {
+      tensor = NestedTensor_contiguous(tensor);
+    }
+    contiguous = contiguous && get_is_contiguous(tensor);
+    buffers.push_back(get_buffer(tensor).reshape({-1}));
+    sizes.push_back(get_efficient_nested_size(tensor).sizes());
+    strides.push_back(get_efficient_nested_stride(tensor).sizes());
+    degree += sizes.back().size(0);
+    numel += buffers.back().numel();
+  }
+  if (degree == 0) {
+    return Tensor();
+  }
+  Tensor buffer = empty_buffer(numel, buffers[0].options());
+  at::cat_out(buffer, buffers, 0);
+  EfficientSizeNode nested_size(degree, at::cat(sizes, 0));
+  if (contiguous) {
+    return wrap_buffer(std::move(buffer), nested_size);
+  }
+  return wrap_buffer(
+      std::move(buffer),
+      nested_size,
+      EfficientSizeNode(degree, at::cat(strides, 0)));
+}
+
+// Concatenates contiguous NestedTensors on the CPU along tensor dimension
+// dim, or stacks them if stack is set, by gathering the rows of their
+// constituents into a new buffer. Returns an undefined Tensor if not
+// applicable, including if the sizes don't match, so that the caller falls
+// back to at::cat for error reporting.
+Tensor _cat_tensor_dim(TensorList tensors, int64_t dim, bool stack) {
+  if (!_buffers_match(tensors) || !get_buffer(tensors[0]).is_cpu()) {
+    return Tensor();
+  }
+  const int64_t num_inputs = tensors.size();
+  const int64_t degree = get_efficient_nested_size(tensors[0]).degree();
+  if (degree == 0) {
+    return Tensor();
+  }
+  std::vector<EfficientSizeNode> nested_sizes;
+  for (const Tensor& tensor : tensors) {
+    if (!get_is_packed(tensor) || !get_is_contiguous(tensor)) {
+      return Tensor();
+    }
+    nested_sizes.push_back(get_efficient_nested_size(tensor));
+    if (nested_sizes.back().degree() != degree) {
+      return Tensor();
+    }
+  }
+  const int64_t tensor_dim = nested_sizes[0].sizes().size(1);
+  const int64_t output_dim = stack ? tensor_dim + 1 : tensor_dim;
+  const int64_t itemsize = get_buffer(tensors[0]).element_size();
+  Tensor output_sizes =
+      empty_buffer(degree * output_dim, TensorOptions().dtype(kLong))
+          .view({degree, output_dim});
+  int64_t* output_sizes_ptr = output_sizes.data_ptr<int64_t>();
+  std::vector<::nested_tensor::cpu::CatSegment> segments(degree);
+  std::vector<int64_t> input_offsets(degree * num_inputs);
+  std::vector<int64_t> chunks(degree * num_inputs);
+  int64_t output_offset = 0;
+  for (int64_t i = 0; i < degree; i++) {
+    const int64_t* size0 =
+        nested_sizes[0].sizes().data_ptr<int64_t>() + i * tensor_dim;
+    int64_t outer = 1;
+    for (int64_t j = 0; j < dim; j++) {
+      outer *= size0[j];
+    }
+    int64_t row_size = 0;
+    int64_t cat_size = 0;
+    for (int64_t k = 0; k < num_inputs; k++) {
+      const int64_t* size =
+          nested_sizes[k].sizes().data_ptr<int64_t>() + i * tensor_dim;
+      int64_t chunk = itemsize;
+      for (int64_t j = 0; j < tensor_dim; j++) {
+        if ((stack || j != dim) && size[j] != size0[j]) {
+          return Tensor();
+        }
+        if (j >= dim) {
+          chunk *= size[j];
+        }
+      }
+      if (!stack) {
+        cat_size += size[dim];
+      }
+      input_offsets[i * num_inputs + k] =
+          nested_sizes[k].offsets()[i] * itemsize;
+      chunks[i * num_inputs + k] = chunk;
+      row_size += chunk;
+    }
+    segments[i] = {output_offset, outer, row_size};
+    output_offset += outer * row_size;
+    int64_t* output_size = output_sizes_ptr + i * output_dim;
+    for (int64_t j = 0, l = 0; j < output_dim; j++) {
+      if (j == dim) {
+        output_size[j] = stack ? num_inputs : cat_size;
+        l += stack ? 0 : 1;
+      } else {
+        output_size[j] = size0[l++];
+      }
+    }
+  }
+  Tensor buffer =
+      empty_buffer(output_offset / itemsize, get_buffer(tensors[0]).options());
+  std::vector<const char*> inputs;
+  for (const Tensor& tensor : tensors) {
+    inputs.push_back(static_cast<const char*>(get_buffer(tensor).data_ptr()));
+  }
+  ::nested_tensor::cpu::cat_kernel(
+      inputs.data(),
+      num_inputs,
+      input_offsets.data(),
+      chunks.data(),
+      static_cast<char*>(buffer.data_ptr()),
+      segments.data(),
+      degree);
+  return wrap_buffer(std::move(buffer), EfficientSizeNode(degree, output_sizes));
+}
+
+} // namespace
+
 std::vector<Tensor> get_stack_inputs(TensorList tensors, int64_t dim) {
   std::vector<Tensor> inputs(tensors.size());
   for (size_t i = 0; i < tensors.size(); ++i) {
@@ -203,6 +502,12 @@ Tensor& NestedTensor_stack_out(
 Tensor NestedTensor_stack(TensorList tensors, int64_t dim) {
   TORCH_CHECK(tensors.size() > 0, "stack expects a non-empty TensorList");
   dim = maybe_wrap_dim(dim, get_dim(tensors[0]) + 1);
+  if (dim > 0) {
+    Tensor result = _cat_tensor_dim(tensors, dim - 1, true);
+    if (result.defined()) {
+      return result;
+    }
+  }
   return at::cat(get_stack_inputs(tensors, dim), dim);
 }
 
@@ -225,7 +530,12 @@ Tensor NestedTensor_cat(TensorList tensors, int64_t dim) {
         dim_0 == get_dim(tensors[i]),
         "Dimension of NestedTensors must match for cat to succeed.");
   }
+  dim = maybe_wrap_dim(dim, dim_0);
   if (dim == 0) {
+    Tensor packed = _cat_nested_dim(tensors);
+    if (packed.defined()) {
+      return packed;
+    }
     std::vector<TensorNode> result;
     for (size_t i = 0; i < tensors.size(); i++) {
       auto unbound = get_nested_tensor_structure(tensors[i]).unbind();
@@ -235,6 +545,12 @@ Tensor NestedTensor_cat(TensorList tensors, int64_t dim) {
     }
     return wrap_tensor_node(TensorNode(std::move(result)));
   }
+  if (nested_dim_0 == 1) {
+    Tensor packed = _cat_tensor_dim(tensors, dim - 1, false);
+    if (packed.defined()) {
+      return packed;
+    }
+  }
   std::vector<std::vector<at::Tensor>> candidates;
   for (size_t i = 0; i < tensors.size(); i++) {
     auto unbound = tensors[i].unbind();
@@ -261,7 +577,6 @@ TORCH_LIBRARY_IMPL(aten, NestedTensor, m) {
   nt_impl(m, "embedding", NestedTensor_embedding);
   nt_impl(m, "any", NestedTensor_any);
   nt_impl(m, "all", NestedTensor_all);
-  nt_impl(m, "_log_softmax", NestedTensor__log_softmax);
   nt_impl(m, "layer_norm", NestedTensor_layer_norm);
   nt_impl(m, "pin_memory", NestedTensor_pin_memory);
   nt_impl(m, "flatten.using_ints", NestedTensor_flatten);
@@ -271,4 +586,13 @@ TORCH_LIBRARY_IMPL(aten, NestedTensor, m) {
   nt_impl(m, "cat.out", NestedTensor_cat_out);
 }
 
+TORCH_LIBRARY_FRAGMENT(nestedtensor, m) {
+  m.def(
+      "add_bias_layer_norm(Tensor input, Tensor residual, Tensor? bias, Tensor? weight, Tensor? layer_bias, float eps=1e-05) -> Tensor");
+  m.impl(
+      "add_bias_layer_norm",
+      NestedTensorKey,
+      TORCH_FN(NestedTensor_add_bias_layer_norm));
+}
+
 } // namespace at
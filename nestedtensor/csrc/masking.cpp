@@ -1,4 +1,5 @@
 #include <nestedtensor/csrc/masking.h>
+#include <nestedtensor/csrc/cpu/padding.h>
 #include <chrono>
 #ifdef WITH_CUDA
 #include <c10/cuda/CUDAStream.h>
@@ -108,19 +109,9 @@ std::vector<int64_t> get_max_size(const Tensor& nt) {
 
 
 Tensor batch_offsets_from_efficient_size(EfficientSizeNode ef) {
-  Tensor ef_sizes = ef.sizes();
-  int64_t* nt_sizes_ptr = ef_sizes.data_ptr<int64_t>();
-  Tensor offsets = torch::empty({1 + ef_sizes.size(0)}, torch::kInt64);
-  int64_t* offsets_ptr = offsets.data_ptr<int64_t>();
-  offsets_ptr[0] = 0;
-  int64_t ef_sizes_size_1 = ef_sizes.size(1);
-  for (int64_t i = 0; i < ef_sizes.size(0); i++) {
-    int64_t prod = 1;
-    for (int64_t j = 0; j < ef_sizes_size_1; j++) {
-      prod = prod * nt_sizes_ptr[i * ef_sizes_size_1 + j];
-    }
-    offsets_ptr[i + 1] = offsets_ptr[i] + prod;
-  }
+  const std::vector<int64_t>& ef_offsets = ef.offsets();
+  Tensor offsets = torch::empty({(int64_t)(ef_offsets.size())}, torch::kInt64);
+  std::copy(ef_offsets.begin(), ef_offsets.end(), offsets.data_ptr<int64_t>());
   return offsets;
 }
 
@@ -508,6 +499,34 @@ Tensor from_padded_tensor(Tensor padded, EfficientSizeNode target_size) {
     return wrap_buffer(std::move(output), target_size);
   }
 #endif
+  if (padded.dim() > 1 && padded.dim() < 5 && padded.is_cpu()) {
+    TORCH_CHECK(
+        padded.size(0) == target_size.degree(),
+        "Padded tensor has ", padded.size(0), " entries, but target size has ",
+        target_size.degree(), ".");
+    Tensor target_size_sizes = target_size.sizes();
+    std::vector<int64_t> max_size =
+        get_max_size_from_efficient_size(target_size);
+    for (size_t i = 0; i < max_size.size(); i++) {
+      TORCH_CHECK(
+          max_size[i] <= padded.size(i + 1),
+          "Target size exceeds size of padded tensor in dimension ", i + 1, ".");
+    }
+    padded = padded.contiguous();
+    Tensor output = torch::empty({target_size.numel()}, padded.options());
+    AT_DISPATCH_ALL_TYPES_AND3(
+        kHalf, kBFloat16, kBool, padded.scalar_type(), "from_padded_tensor", [&] {
+          nested_tensor::cpu::remove_padding_kernel<scalar_t>(
+              padded.data_ptr<scalar_t>(),
+              output.data_ptr<scalar_t>(),
+              target_size.offsets().data(),
+              padded.sizes().data(),
+              target_size_sizes.data_ptr<int64_t>(),
+              padded.dim() - 1,
+              padded.size(0));
+        });
+    return wrap_buffer(std::move(output), target_size);
+  }
   at::Tensor target_size_tensor = std::get<0>(at::max(target_size.sizes(), 0));
   std::vector<int64_t> target_size_vec(target_size_tensor.data_ptr<int64_t>(),
       target_size_tensor.data_ptr<int64_t>() + target_size_tensor.numel());
@@ -629,11 +648,41 @@ Tensor to_padded_tensor(Tensor nt, double padding) {
     nt = NestedTensor_contiguous(nt);
     return get_buffer(nt);
   }
-  auto max_size = get_max_size(nt);
-  TensorNode structure = get_nested_tensor_structure(nt);
-  if (structure.degree() == 0) {
+  if (get_efficient_nested_size(nt).degree() == 0) {
     return torch::tensor({padding});
   }
+  if (get_dim(nt) >= 2 && get_dim(nt) <= 4 && get_buffer(nt).is_cpu()) {
+    nt = NestedTensor_contiguous(nt, c10::MemoryFormat::Contiguous);
+    auto nt_opt_size = get_opt_sizes(nt);
+    // A regular last dimension makes for longer contiguous rows.
+    const bool collapse = get_dim(nt) == 3 && nt_opt_size[2] && *nt_opt_size[2] > 0;
+    if (collapse) {
+      nt = _collapse_two_dims_3(nt, 1, 2);
+    }
+    auto esize = get_efficient_nested_size(nt);
+    Tensor nt_sizes = esize.sizes();
+    Tensor nt_buffer = get_buffer(nt);
+    std::vector<int64_t> new_size = padded_size_from_efficient_size(esize);
+    Tensor output = at::empty(IntArrayRef(new_size), nt_buffer.options());
+    AT_DISPATCH_ALL_TYPES_AND3(
+        kHalf, kBFloat16, kBool, nt_buffer.scalar_type(), "to_padded_tensor", [&] {
+          nested_tensor::cpu::add_padding_kernel<scalar_t>(
+              nt_buffer.data_ptr<scalar_t>(),
+              output.data_ptr<scalar_t>(),
+              static_cast<scalar_t>(padding),
+              esize.offsets().data(),
+              nt_sizes.data_ptr<int64_t>(),
+              nt_sizes.size(1),
+              new_size,
+              nt_sizes.size(0));
+        });
+    if (collapse) {
+      output = output.reshape({output.size(0), -1, *nt_opt_size[2]});
+    }
+    return output;
+  }
+  auto max_size = get_max_size(nt);
+  TensorNode structure = get_nested_tensor_structure(nt);
   std::vector<Tensor> res_tensor;
   for (auto child : structure.unbind()) {
     at::Tensor tensor = child.payload();
@@ -1,13 +1,296 @@
+#include <nestedtensor/csrc/cpu/linear.h>
+#include <nestedtensor/csrc/cpu/parallel.h>
 #include <nestedtensor/csrc/nested_tensor_impl.h>
 #include <nestedtensor/csrc/utils/nested_node_functions.h>
 #include <torch/extension.h>
 #include <torch/library.h>
+#include <algorithm>
+#include <map>
 
 using namespace torch::nn;
 namespace F = torch::nn::functional;
 
 namespace at {
 
+namespace {
+
+// A run of constituents with the same shape and strides that are evenly
+// spaced in memory can be described by a single batched view.
+bool _is_uniform_run(
+    const std::vector<int64_t>& members,
+    const std::vector<torch::nested_tensor::impl::ConstituentView>& views) {
+  const auto& first = views[members[0]];
+  for (size_t j = 1; j < members.size(); j++) {
+    const auto& view = views[members[j]];
+    if (members[j] != members[0] + (int64_t)(j) ||
+        view.stride_ref() != first.stride_ref() ||
+        view.offset - views[members[j - 1]].offset !=
+            views[members[1]].offset - first.offset) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns the given constituents as a [count * batch, rows, cols] Tensor.
+// This is a view into buffer if possible and a copy otherwise.
+Tensor _batch_constituents(
+    const Tensor& buffer,
+    const std::vector<int64_t>& members,
+    const std::vector<torch::nested_tensor::impl::ConstituentView>& views) {
+  const auto& first = views[members[0]];
+  if (_is_uniform_run(members, views)) {
+    std::vector<int64_t> sizes(first.size_ref().begin(), first.size_ref().end());
+    std::vector<int64_t> strides(
+        first.stride_ref().begin(), first.stride_ref().end());
+    sizes.insert(sizes.begin(), members.size());
+    strides.insert(
+        strides.begin(),
+        members.size() > 1 ? views[members[1]].offset - first.offset : 1);
+    return at::as_strided(
+               buffer, sizes, strides, buffer.storage_offset() + first.offset)
+        .reshape({-1, sizes[sizes.size() - 2], sizes[sizes.size() - 1]});
+  }
+  std::vector<Tensor> tensors;
+  tensors.reserve(members.size());
+  for (int64_t i : members) {
+    tensors.push_back(torch::nested_tensor::impl::constituent(buffer, views[i]));
+  }
+  Tensor stacked = at::stack(tensors);
+  return stacked.reshape(
+      {-1, stacked.size(stacked.dim() - 2), stacked.size(stacked.dim() - 1)});
+}
+
+// Grouped GEMM for NestedTensor x NestedTensor on CPU. Constituents are
+// bucketed by shape and each bucket runs as a single bmm. Buckets with a
+// single constituent are computed in parallel with one GEMM each. All
+// results are written into one packed output buffer. Returns an undefined
+// Tensor if the inputs aren't supported.
+Tensor _grouped_matmul(const Tensor& self, const Tensor& other) {
+  const int64_t dim = get_dim(self);
+  if (get_dim(other) != dim || (dim != 3 && dim != 4) ||
+      !get_buffer(self).is_cpu() || !get_buffer(other).is_cpu() ||
+      self.scalar_type() != other.scalar_type()) {
+    return Tensor();
+  }
+  auto self_impl = get_nested_tensor_impl(self);
+  auto other_impl = get_nested_tensor_impl(other);
+  const int64_t degree = self_impl->get_nested_size().degree();
+  if (other_impl->get_nested_size().degree() != degree || degree == 0) {
+    return Tensor();
+  }
+  // Constituents are matrices or batches of matrices.
+  const int64_t width = dim - 1;
+  std::vector<torch::nested_tensor::impl::ConstituentView> self_views;
+  std::vector<torch::nested_tensor::impl::ConstituentView> other_views;
+  self_views.reserve(degree);
+  other_views.reserve(degree);
+  at::Tensor result_sizes = torch::empty({degree, width}, torch::kInt64);
+  int64_t* result_sizes_ptr = result_sizes.data_ptr<int64_t>();
+  std::map<std::vector<int64_t>, std::vector<int64_t>> buckets;
+  for (int64_t i = 0; i < degree; i++) {
+    self_views.push_back(self_impl->constituent_view(i));
+    other_views.push_back(other_impl->constituent_view(i));
+    const int64_t* s = self_views[i].sizes;
+    const int64_t* o = other_views[i].sizes;
+    if (s[width - 1] != o[width - 2] || (width == 3 && s[0] != o[0])) {
+      return Tensor();
+    }
+    if (width == 3) {
+      result_sizes_ptr[i * width] = s[0];
+    }
+    result_sizes_ptr[i * width + width - 2] = s[width - 2];
+    result_sizes_ptr[i * width + width - 1] = o[width - 1];
+    std::vector<int64_t> key(s, s + width);
+    key.push_back(o[width - 1]);
+    buckets[key].push_back(i);
+  }
+  EfficientSizeNode result_size(self_impl->get_nested_size().structure(), result_sizes);
+  EfficientSizeNode result_stride = torch::nested_tensor::impl::_cont_stride(result_size);
+  Tensor self_buffer = get_buffer(self);
+  Tensor other_buffer = get_buffer(other);
+  Tensor result_buffer = at::empty({result_size.numel()}, self_buffer.options());
+  std::vector<torch::nested_tensor::impl::ConstituentView> result_views;
+  result_views.reserve(degree);
+  for (int64_t i = 0; i < degree; i++) {
+    result_views.push_back(
+        torch::nested_tensor::impl::constituent_view(result_size, result_stride, i));
+  }
+
+  std::vector<int64_t> singletons;
+  for (const auto& bucket : buckets) {
+    const std::vector<int64_t>& members = bucket.second;
+    if (members.size() == 1) {
+      singletons.push_back(members[0]);
+      continue;
+    }
+    Tensor self_batch = _batch_constituents(self_buffer, members, self_views);
+    Tensor other_batch = _batch_constituents(other_buffer, members, other_views);
+    if (_is_uniform_run(members, result_views)) {
+      Tensor result_batch = _batch_constituents(result_buffer, members, result_views);
+      at::bmm_out(result_batch, self_batch, other_batch);
+      continue;
+    }
+    Tensor result_batch = at::bmm(self_batch, other_batch)
+                              .view({(int64_t)(members.size()), -1});
+    for (size_t j = 0; j < members.size(); j++) {
+      torch::nested_tensor::impl::constituent(result_buffer, result_views[members[j]])
+          .view({-1})
+          .copy_(result_batch[j]);
+    }
+  }
+
+  at::ThreadLocalState state;
+  at::parallel_for(0, singletons.size(), 1, [&](int64_t begin, int64_t end) {
+    at::ThreadLocalStateGuard guard(state);
+    for (int64_t j = begin; j < end; j++) {
+      const int64_t i = singletons[j];
+      Tensor result_i = torch::nested_tensor::impl::constituent(result_buffer, result_views[i]);
+      at::matmul_out(
+          result_i,
+          torch::nested_tensor::impl::constituent(self_buffer, self_views[i]),
+          torch::nested_tensor::impl::constituent(other_buffer, other_views[i]));
+    }
+  });
+  return wrap_buffer(std::move(result_buffer), result_size, result_stride);
+}
+
+::nested_tensor::cpu::Activation _parse_activation(c10::string_view activation) {
+  if (activation == "none") {
+    return ::nested_tensor::cpu::Activation::None;
+  }
+  if (activation == "relu") {
+    return ::nested_tensor::cpu::Activation::Relu;
+  }
+  if (activation == "gelu") {
+    return ::nested_tensor::cpu::Activation::Gelu;
+  }
+  if (activation == "silu") {
+    return ::nested_tensor::cpu::Activation::Silu;
+  }
+  TORCH_CHECK(
+      false,
+      "Unsupported activation ",
+      activation,
+      ". Expected one of none, relu, gelu or silu.");
+  return ::nested_tensor::cpu::Activation::None;
+}
+
+Tensor _apply_activation(
+    const Tensor& tensor,
+    ::nested_tensor::cpu::Activation activation) {
+  switch (activation) {
+    case ::nested_tensor::cpu::Activation::Relu:
+      return at::relu(tensor);
+    case ::nested_tensor::cpu::Activation::Gelu:
+      return at::gelu(tensor);
+    case ::nested_tensor::cpu::Activation::Silu:
+      return at::silu(tensor);
+    default:
+      return tensor;
+  }
+}
+
+// Computes activation(input @ weight.T + bias) + residual for a contiguous
+// CPU NestedTensor. The rows of the packed buffer are split into tiles that
+// are processed in parallel. Each tile runs one GEMM into the output buffer
+// and then applies the epilogue while the tile is still in cache, so the
+// output is written only once. Returns an undefined Tensor if the inputs
+// aren't supported.
+Tensor _fused_linear_cpu(
+    const Tensor& input,
+    const Tensor& weight,
+    const c10::optional<Tensor>& bias,
+    ::nested_tensor::cpu::Activation activation,
+    const c10::optional<Tensor>& residual) {
+  if (is_nested_tensor_impl(weight) || weight.dim() != 2 ||
+      get_nested_dim(input) != 1 || get_dim(input) < 2 ||
+      !get_is_contiguous(input)) {
+    return Tensor();
+  }
+  const int64_t in_features = weight.size(1);
+  const int64_t out_features = weight.size(0);
+  auto opt_sizes = get_opt_sizes(input);
+  Tensor buffer = get_buffer(input);
+  const ScalarType dtype = buffer.scalar_type();
+  if (!opt_sizes.back() || *opt_sizes.back() != in_features ||
+      in_features == 0 || !buffer.is_cpu() || !weight.is_cpu() ||
+      weight.scalar_type() != dtype ||
+      !(dtype == kFloat || dtype == kDouble || dtype == kBFloat16)) {
+    return Tensor();
+  }
+  if (bias &&
+      (is_nested_tensor_impl(*bias) || !bias->is_cpu() ||
+       bias->scalar_type() != dtype || bias->dim() != 1 ||
+       bias->numel() != out_features)) {
+    return Tensor();
+  }
+  // The buffer of a contiguous NestedTensor may extend past its last
+  // constituent, so the rows are taken from the nested size.
+  const int64_t rows = get_efficient_nested_size(input).numel() / in_features;
+  EfficientSizeNode result_size = map_efficient_size(
+      [out_features](int64_t* size_ptr, int64_t size) {
+        size_ptr[size - 1] = out_features;
+      },
+      get_efficient_nested_size(input));
+  Tensor residual_buffer;
+  if (residual) {
+    if (!is_nested_tensor_impl(*residual) ||
+        !get_is_contiguous(*residual) ||
+        !efficient_size_matches(
+            result_size, get_efficient_nested_size(*residual))) {
+      return Tensor();
+    }
+    residual_buffer = get_buffer(*residual);
+    if (!residual_buffer.is_cpu() || residual_buffer.scalar_type() != dtype) {
+      return Tensor();
+    }
+    residual_buffer = residual_buffer.narrow(0, 0, rows * out_features);
+  }
+  Tensor input_matrix =
+      buffer.narrow(0, 0, rows * in_features).view({rows, in_features});
+  Tensor weight_t = weight.t();
+  Tensor bias_ = bias ? bias->contiguous() : Tensor();
+  Tensor output = empty_buffer(rows * out_features, buffer.options());
+  Tensor output_matrix = output.view({rows, out_features});
+  const bool has_epilogue = bias_.defined() || residual_buffer.defined() ||
+      activation != ::nested_tensor::cpu::Activation::None;
+  // Tiles are sized to keep their output in L2.
+  const int64_t tile_rows = ::nested_tensor::cpu::rows_per_tile(
+      rows, out_features * buffer.element_size(), 1 << 18);
+  const int64_t num_tiles = (rows + tile_rows - 1) / tile_rows;
+  at::ThreadLocalState state;
+  at::parallel_for(0, num_tiles, 1, [&](int64_t begin, int64_t end) {
+    at::ThreadLocalStateGuard guard(state);
+    for (int64_t tile = begin; tile < end; tile++) {
+      const int64_t row_begin = tile * tile_rows;
+      const int64_t row_count = std::min(tile_rows, rows - row_begin);
+      Tensor output_tile = output_matrix.narrow(0, row_begin, row_count);
+      at::mm_out(
+          output_tile, input_matrix.narrow(0, row_begin, row_count), weight_t);
+      if (!has_epilogue) {
+        continue;
+      }
+      AT_DISPATCH_FLOATING_TYPES_AND(
+          kBFloat16, dtype, "NestedTensor_linear_epilogue", [&] {
+            ::nested_tensor::cpu::linear_epilogue_kernel<scalar_t>(
+                output_tile.data_ptr<scalar_t>(),
+                bias_.defined() ? bias_.data_ptr<scalar_t>() : nullptr,
+                residual_buffer.defined()
+                    ? residual_buffer.data_ptr<scalar_t>() +
+                        row_begin * out_features
+                    : nullptr,
+                row_count,
+                out_features,
+                activation);
+          });
+    }
+  });
+  return wrap_buffer(std::move(output), result_size);
+}
+
+} // namespace
+
 Tensor NestedTensor_matmul(const Tensor& self, const Tensor& other) {
   if (is_nested_tensor_impl(self) && !is_nested_tensor_impl(other)) {
     if (get_is_contiguous(self)) {
@@ -43,13 +326,50 @@ Tensor NestedTensor_matmul(const Tensor& self, const Tensor& other) {
       }
     }
   }
+  if (is_nested_tensor_impl(self, other)) {
+    Tensor result = _grouped_matmul(self, other);
+    if (result.defined()) {
+      return result;
+    }
+  }
   return map_nested_tensor(
       [](at::Tensor self, at::Tensor other) { return at::matmul(self, other); },
       self,
       other);
 }
 
+Tensor NestedTensor_linear(
+    const Tensor& input,
+    const Tensor& weight,
+    const c10::optional<Tensor>& bias,
+    c10::string_view activation,
+    const c10::optional<Tensor>& residual) {
+  TORCH_CHECK(
+      is_nested_tensor_impl(input), "Expected input to be a NestedTensor.");
+  ::nested_tensor::cpu::Activation activation_ = _parse_activation(activation);
+  Tensor result =
+      _fused_linear_cpu(input, weight, bias, activation_, residual);
+  if (result.defined()) {
+    return result;
+  }
+  result = at::matmul(input, weight.t());
+  if (bias) {
+    result = at::add(result, *bias);
+  }
+  result = _apply_activation(result, activation_);
+  if (residual) {
+    result = at::add(result, *residual);
+  }
+  return result;
+}
+
 TORCH_LIBRARY_IMPL(aten, NestedTensor, m) {
   nt_impl(m, "matmul", NestedTensor_matmul);
 }
+
+TORCH_LIBRARY_FRAGMENT(nestedtensor, m) {
+  m.def(
+      "linear(Tensor input, Tensor weight, Tensor? bias=None, str activation=\"none\", Tensor? residual=None) -> Tensor");
+  m.impl("linear", NestedTensorKey, TORCH_FN(NestedTensor_linear));
+}
 } // namespace at
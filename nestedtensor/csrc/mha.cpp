@@ -1,3 +1,4 @@
+#include <nestedtensor/csrc/cpu/softmax.h>
 #include <nestedtensor/csrc/creation.h>
 #include <nestedtensor/csrc/nested_tensor_impl.h>
 #include <nestedtensor/csrc/python_functions.h>
@@ -15,6 +16,82 @@ using namespace at;
 namespace torch {
 namespace nested_tensor {
 
+// Self-attention over the packed buffer of a contiguous CPU NestedTensor.
+// The QKV projection is a single GEMM over all tokens. Attention is then
+// computed for each sequence at its true length and written directly into a
+// packed output buffer, so no padding to the maximum length is ever
+// materialized.
+at::Tensor _min_mha_cpu(
+    int64_t num_heads,
+    int64_t head_dim,
+    at::Tensor query,
+    at::Tensor in_proj_weight,
+    at::Tensor in_proj_bias,
+    double scaling,
+    at::Tensor out_proj_weight,
+    at::Tensor out_proj_bias) {
+  const int64_t edim = num_heads * head_dim;
+  auto esize = get_efficient_nested_size(query);
+  at::Tensor input = get_buffer(query).view({-1, edim});
+  at::Tensor qkv = at::addmm(in_proj_bias, input, in_proj_weight.t());
+  at::Tensor attn = at::empty_like(input);
+  const std::vector<int64_t>& offsets = esize.offsets();
+  at::Tensor sizes = esize.sizes();
+  const int64_t* sizes_ptr = sizes.data_ptr<int64_t>();
+  const int64_t batch_size = esize.degree();
+
+  auto attend = [&](int64_t i) {
+    const int64_t start = offsets[i] / edim;
+    const int64_t seq_len = sizes_ptr[i * 2];
+    if (seq_len == 0) {
+      return;
+    }
+    at::Tensor qkv_i = qkv.narrow(0, start, seq_len);
+    // [num_heads, seq_len, head_dim] views into the projection.
+    at::Tensor q = qkv_i.narrow(1, 0, edim)
+                       .view({seq_len, num_heads, head_dim})
+                       .transpose(0, 1);
+    at::Tensor k = qkv_i.narrow(1, edim, edim)
+                       .view({seq_len, num_heads, head_dim})
+                       .permute({1, 2, 0});
+    at::Tensor v = qkv_i.narrow(1, 2 * edim, edim)
+                       .view({seq_len, num_heads, head_dim})
+                       .transpose(0, 1);
+    at::Tensor scores = at::bmm(q, k);
+    AT_DISPATCH_FLOATING_TYPES_AND(
+        at::ScalarType::BFloat16, scores.scalar_type(), "min_mha_softmax", [&] {
+          ::nested_tensor::cpu::scaled_softmax_kernel<scalar_t>(
+              scores.data_ptr<scalar_t>(),
+              num_heads * seq_len,
+              seq_len,
+              scaling);
+        });
+    attn.narrow(0, start, seq_len)
+        .view({seq_len, num_heads, head_dim})
+        .transpose(0, 1)
+        .copy_(at::bmm(scores, v));
+  };
+
+  // With enough sequences each thread works on whole sequences and runs the
+  // ATen ops within single threaded. Otherwise the ops parallelize
+  // internally.
+  if (batch_size >= at::get_num_threads()) {
+    at::ThreadLocalState state;
+    at::parallel_for(0, batch_size, 1, [&](int64_t begin, int64_t end) {
+      at::ThreadLocalStateGuard guard(state);
+      for (int64_t i = begin; i < end; i++) {
+        attend(i);
+      }
+    });
+  } else {
+    for (int64_t i = 0; i < batch_size; i++) {
+      attend(i);
+    }
+  }
+  at::Tensor output = at::addmm(out_proj_bias, attn, out_proj_weight.t());
+  return wrap_buffer(output.view({-1}), esize);
+}
+
 at::Tensor min_mha(
     int64_t num_heads,
     int64_t head_dim,
@@ -37,6 +114,22 @@ at::Tensor min_mha(
     throw std::runtime_error("query's third dimension must be regular.");
   }
   int64_t edim = *(opt_sizes[2]);
+  if (query.is_same(key) && key.is_same(value) &&
+      get_buffer(query).is_cpu() && get_is_contiguous(query) &&
+      (!training || dropout_p == 0) && edim == num_heads * head_dim &&
+      (query.scalar_type() == at::kFloat ||
+       query.scalar_type() == at::kDouble ||
+       query.scalar_type() == at::kBFloat16)) {
+    return _min_mha_cpu(
+        num_heads,
+        head_dim,
+        query,
+        in_proj_weight,
+        *in_proj_bias,
+        scaling,
+        out_proj_weight,
+        out_proj_bias);
+  }
 
   at::Tensor q, k, v;
   q = at::matmul(
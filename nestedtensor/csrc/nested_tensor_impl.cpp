@@ -209,10 +209,16 @@ std::vector<at::Tensor> NestedTensor_unbind(
     int64_t dim) {
   auto _data = get_nested_tensor_impl(self);
   dim = at::maybe_wrap_dim(dim, get_dim(self));
-  auto node = _data->get_structure();
   if (dim == 0) {
-    return wrap_tensor_node(node.unbind());
+    // The cached structure must not escape, so hand out new views.
+    std::vector<at::Tensor> result;
+    result.reserve(_data->get_nested_size().degree());
+    for (int64_t i = 0; i < _data->get_nested_size().degree(); i++) {
+      result.push_back(_data->constituent(i));
+    }
+    return result;
   }
+  auto node = _data->get_structure();
   std::vector<std::vector<TensorNode>> unbound;
   for (auto child : node.unbind()) {
     std::vector<at::Tensor> tmp =
@@ -231,14 +237,96 @@ std::vector<at::Tensor> NestedTensor_unbind(
   return wrap_tensor_node(result);
 }
 
+// Returns a view of the constituents of self given by indices. The view
+// shares the buffer of self and only gathers the rows of its nested size and
+// stride tables. A range of constituents of a NestedTensor with packed
+// constituents is cut out of the buffer and stays packed. Otherwise the view
+// records the offset of each of its constituents within the buffer.
+Tensor _select_constituents(
+    const Tensor& self,
+    const std::vector<int64_t>& indices) {
+  if (indices.empty()) {
+    return wrap_tensor_node(TensorNode(std::vector<TensorNode>()));
+  }
+  auto impl = get_nested_tensor_impl(self);
+  EfficientSizeNode nested_size = impl->get_nested_size();
+  EfficientSizeNode nested_stride = impl->get_nested_stride();
+  const std::vector<int64_t>* storage_offsets =
+      nested_stride.storage_offsets();
+  const std::vector<int64_t>& offsets =
+      storage_offsets ? *storage_offsets : nested_size.offsets();
+  const int64_t degree = indices.size();
+  Tensor index = at::tensor(indices, kLong);
+  Tensor sizes = nested_size.sizes().index_select(0, index);
+  Tensor strides = nested_stride.sizes().index_select(0, index);
+  Tensor buffer = impl->get_buffer().reshape({-1});
+  bool is_range = !storage_offsets;
+  for (int64_t i = 1; i < degree && is_range; i++) {
+    is_range = indices[i] == indices[0] + i;
+  }
+  if (is_range) {
+    // Constituents with arbitrary strides may extend past the offset of the
+    // next constituent, so only packed buffers are cut off at the end.
+    const bool packed = get_is_contiguous(self) ||
+        get_is_contiguous(self, MemoryFormat::ChannelsLast);
+    const int64_t start = offsets[indices[0]];
+    const int64_t end =
+        packed ? offsets[indices[degree - 1] + 1] : buffer.numel();
+    return wrap_buffer(
+        buffer.narrow(0, start, end - start),
+        EfficientSizeNode(degree, sizes),
+        EfficientSizeNode(degree, strides));
+  }
+  auto new_offsets = std::make_shared<std::vector<int64_t>>(degree);
+  for (int64_t i = 0; i < degree; i++) {
+    (*new_offsets)[i] = offsets[indices[i]];
+  }
+  return wrap_buffer(
+      std::move(buffer),
+      EfficientSizeNode(degree, sizes),
+      EfficientSizeNode(degree, strides, std::move(new_offsets)));
+}
+
+Tensor NestedTensor_index_select(
+    const Tensor& self,
+    int64_t dim,
+    const Tensor& index) {
+  dim = maybe_wrap_dim(dim, get_dim(self));
+  TORCH_CHECK_INDEX(dim == 0, "index_select() only supports dim == 0 for now.");
+  TORCH_CHECK_INDEX(
+      index.dim() <= 1, "index_select(): Index is supposed to be a vector.");
+  TORCH_CHECK_INDEX(
+      index.scalar_type() == kLong || index.scalar_type() == kInt,
+      "index_select(): Expected dtype int32 or int64 for index.");
+  const int64_t degree = get_nested_tensor_impl(self)->get_nested_size().degree();
+  Tensor index_ = index.to(kCPU, kLong).contiguous();
+  const int64_t* index_ptr = index_.data_ptr<int64_t>();
+  std::vector<int64_t> indices(index_ptr, index_ptr + index_.numel());
+  for (int64_t i : indices) {
+    TORCH_CHECK_INDEX(
+        i >= 0 && i < degree,
+        "index_select(): index ", i, " out of range for NestedTensor of size ",
+        degree, ".");
+  }
+  return _select_constituents(self, indices);
+}
+
 Tensor NestedTensor_select(const Tensor& self, int64_t dim, int64_t index) {
   int64_t ndim = get_dim(self);
   dim = maybe_wrap_dim(dim, ndim);
   if (dim != 0) {
     TORCH_CHECK_INDEX(false, "select() only supports dim == 0 for now.");
   }
-  auto tmp = get_nested_tensor_structure(self).unbind()[index];
-  return wrap_tensor_node(std::move(tmp));
+  auto self_impl = get_nested_tensor_impl(self);
+  int64_t degree = self_impl->get_nested_size().degree();
+  TORCH_CHECK_INDEX(
+      index >= -degree && index < degree,
+      "select(): index ", index, " out of range for NestedTensor of size ",
+      degree, ".");
+  if (index < 0) {
+    index = index + degree;
+  }
+  return self_impl->constituent(index);
 }
 
 Tensor NestedTensor_to_nested_tensor(
@@ -323,16 +411,11 @@ Tensor NestedTensor_slice(
   } else if (end >= sizes_0) {
     end = sizes_0;
   }
-  std::vector<at::Tensor> unbound = at::unbind(self, 0);
-  std::vector<TensorNode> new_tensor_nodes;
+  std::vector<int64_t> indices;
   for (int64_t i = start; i < end; i += step) {
-    if (is_nested_tensor_impl(unbound[i])) {
-      new_tensor_nodes.push_back(get_nested_tensor_structure(unbound[i]));
-    } else {
-      new_tensor_nodes.push_back(TensorNode(std::move(unbound[i])));
-    }
+    indices.push_back(i);
   }
-  auto result = wrap_tensor_node(TensorNode(std::move(new_tensor_nodes)));
+  auto result = _select_constituents(self, indices);
   namedinference::propagate_names(result, self);
   return result;
 }
@@ -345,6 +428,28 @@ Tensor& NestedTensor_copy_(Tensor& self, const Tensor& src, bool non_blocking) {
   return self;
 }
 
+// Removes tensor dimension dim, which must have size 1 in every
+// constituent, from the nested sizes and strides of self.
+Tensor _squeeze_tensor_dim(const Tensor& self, int64_t dim) {
+  return view_nested_tensor(
+      [dim](const int64_t* size,
+            const int64_t* stride,
+            int64_t tensor_dim,
+            int64_t* new_size,
+            int64_t* new_stride) {
+        for (int64_t j = 0, k = 0; j < tensor_dim; j++) {
+          if (j != dim) {
+            new_size[k] = size[j];
+            new_stride[k] = stride[j];
+            k++;
+          }
+        }
+        return true;
+      },
+      self,
+      get_dim(self) - get_nested_dim(self) - 1);
+}
+
 Tensor _NestedTensor_squeeze_(Tensor self, c10::optional<int64_t> dim_) {
   auto self_impl = get_nested_tensor_impl(self);
   if (!dim_) {
@@ -371,6 +476,10 @@ Tensor _NestedTensor_squeeze_(Tensor self, c10::optional<int64_t> dim_) {
     return wrap_tensor_node(
         _squeeze_nested_dim(self_impl->get_structure(), dim));
   }
+  Tensor result = _squeeze_tensor_dim(self, dim - self_impl->nested_dim());
+  if (result.defined()) {
+    return result;
+  }
   int64_t height = self_impl->get_structure().height();
   return map_nested_tensor(
       [dim, height](at::Tensor tensor) { return tensor.squeeze(dim - height); },
@@ -397,6 +506,10 @@ Tensor NestedTensor_squeeze_dim(const Tensor& self, int64_t dim) {
       ((self_impl->opt_sizes()[dim]) &&
        ((*(self_impl->opt_sizes()[dim])) == 1)),
       "Given dimension is either undefined or not a singleton.");
+  Tensor result = _squeeze_tensor_dim(self, dim - nested_dim);
+  if (result.defined()) {
+    return result;
+  }
   return map_nested_tensor(
       [dim, nested_dim](at::Tensor tensor) {
         return tensor.squeeze(dim - nested_dim);
@@ -415,6 +528,32 @@ Tensor NestedTensor_unsqueeze(const Tensor& self, int64_t dim) {
     one_node.push_back(get_nested_tensor_structure(self));
     return wrap_tensor_node(TensorNode(std::move(one_node)));
   }
+  // Inserts a dimension of size 1 with the same stride as at::unsqueeze.
+  const int64_t new_dim = dim - get_nested_dim(self);
+  Tensor result = view_nested_tensor(
+      [new_dim](
+          const int64_t* size,
+          const int64_t* stride,
+          int64_t tensor_dim,
+          int64_t* new_size,
+          int64_t* new_stride) {
+        for (int64_t j = 0, k = 0; j <= tensor_dim; j++) {
+          if (j == new_dim) {
+            new_size[j] = 1;
+            new_stride[j] = j < tensor_dim ? size[j] * stride[j] : 1;
+          } else {
+            new_size[j] = size[k];
+            new_stride[j] = stride[k];
+            k++;
+          }
+        }
+        return true;
+      },
+      self,
+      get_dim(self) - get_nested_dim(self) + 1);
+  if (result.defined()) {
+    return result;
+  }
   std::vector<TensorNode> result_nodes;
   auto unbound = self.unbind(0);
   for (size_t i = 0; i < unbound.size(); i++) {
@@ -447,6 +586,7 @@ Tensor NestedTensor_to_dtype_layout(
 TORCH_LIBRARY_IMPL(aten, NestedTensor, m) {
   nt_impl(m, "contiguous", NestedTensor_contiguous);
   nt_impl(m, "copy_", NestedTensor_copy_);
+  nt_impl(m, "index_select", NestedTensor_index_select);
   nt_impl(m, "is_pinned", NestedTensor_is_pinned);
   nt_impl(m, "select.int", NestedTensor_select);
   nt_impl(m, "size.int", NestedTensor_size_int);
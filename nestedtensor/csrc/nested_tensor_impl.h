@@ -1,6 +1,8 @@
 #pragma once
 #include <ATen/ATen.h>
 #include <ATen/MemoryOverlap.h>
+#include <ATen/Parallel.h>
+#include <ATen/ThreadLocalState.h>
 #include <c10/util/Metaprogramming.h>
 #include <nestedtensor/csrc/storage/Packed.h>
 #include <nestedtensor/csrc/utils/nested_node.h>
@@ -69,11 +71,29 @@ struct NestedTensorImpl : public c10::TensorImpl {
         "is_contiguous is disabled. These methods are not virtual in fbcode.");
   }
 #endif
+  // The constituents as at::Tensor views. These are created on first use
+  // and cached, since many fallbacks call this on every op. The returned
+  // Tensors are shared with the cache and must not be modified in place
+  // or handed out to users. Use constituent or for_each_constituent to
+  // access constituents without materializing a TensorNode.
   TensorNode get_structure() const {
-    return std::get<0>(torch::nested_tensor::impl::build_structure(
-        _buffer.reshape({-1}),
-        _nested_size,
-        _nested_stride));
+    std::lock_guard<std::mutex> guard(_structure_mutex);
+    if (!_structure) {
+      _structure = std::make_shared<TensorNode>(
+          std::get<0>(torch::nested_tensor::impl::build_structure(
+              _buffer.reshape({-1}), _nested_size, _nested_stride)));
+    }
+    return *_structure;
+  }
+  torch::nested_tensor::impl::ConstituentView constituent_view(
+      int64_t i) const {
+    return torch::nested_tensor::impl::constituent_view(
+        _nested_size, _nested_stride, i);
+  }
+  // A new at::Tensor view of constituent i that is safe to return to users.
+  at::Tensor constituent(int64_t i) const {
+    return torch::nested_tensor::impl::constituent(
+        _buffer, constituent_view(i));
   }
   EfficientSizeNode get_nested_size() {
     return _nested_size;
@@ -170,6 +190,8 @@ struct NestedTensorImpl : public c10::TensorImpl {
   bool _is_pinned;
   const bool _is_contiguous;
   const bool _is_contiguous_channels_last;
+  mutable std::mutex _structure_mutex;
+  mutable std::shared_ptr<TensorNode> _structure;
 };
 
 int64_t nt_size(Tensor tensor, int64_t dim);
@@ -264,6 +286,20 @@ inline bool get_is_contiguous(
   return tensor.is_contiguous(memory_format);
 }
 
+// Returns true if the constituents of tensor fill its buffer exactly, either
+// contiguously or in channels last format. An elementwise operation can then
+// be applied to the buffer in a single call.
+inline bool get_is_packed(const at::Tensor& tensor) {
+  if (!is_nested_tensor_impl(tensor)) {
+    return tensor.is_contiguous() ||
+        tensor.is_contiguous(MemoryFormat::ChannelsLast);
+  }
+  auto impl = get_nested_tensor_impl(tensor);
+  return (impl->get_is_contiguous(MemoryFormat::Contiguous) ||
+          impl->get_is_contiguous(MemoryFormat::ChannelsLast)) &&
+      impl->get_buffer().numel() == impl->get_nested_size().numel();
+}
+
 inline bool get_is_cuda(
     const at::Tensor& tensor,
     at::MemoryFormat memory_format = MemoryFormat::Contiguous) {
@@ -291,6 +327,51 @@ at::Tensor wrap_buffer(
     at::Tensor&&,
     EfficientSizeNode efficient_nested_size);
 
+// Returns a view of self that shares its buffer and has new nested sizes and
+// strides of tensor dimension new_dim. For each constituent
+//   fn(size, stride, dim, new_size, new_stride)
+// fills in the new sizes and strides from the current ones and returns false
+// if the constituent can't be viewed that way, in which case an undefined
+// Tensor is returned. Also returns an undefined Tensor if self has no
+// constituents.
+template <class F>
+inline at::Tensor view_nested_tensor(
+    F&& fn,
+    const at::Tensor& self,
+    int64_t new_dim) {
+  EfficientSizeNode nested_size = get_efficient_nested_size(self);
+  EfficientSizeNode nested_stride = get_efficient_nested_stride(self);
+  const int64_t degree = nested_size.degree();
+  if (degree == 0) {
+    return at::Tensor();
+  }
+  const int64_t dim = nested_size.sizes().size(1);
+  const int64_t* size_ptr = nested_size.sizes().data_ptr<int64_t>();
+  const int64_t* stride_ptr = nested_stride.sizes().data_ptr<int64_t>();
+  at::Tensor new_sizes =
+      empty_buffer(degree * new_dim, at::TensorOptions().dtype(at::kLong))
+          .view({degree, new_dim});
+  at::Tensor new_strides =
+      empty_buffer(degree * new_dim, at::TensorOptions().dtype(at::kLong))
+          .view({degree, new_dim});
+  int64_t* new_size_ptr = new_sizes.data_ptr<int64_t>();
+  int64_t* new_stride_ptr = new_strides.data_ptr<int64_t>();
+  for (int64_t i = 0; i < degree; i++) {
+    if (!fn(size_ptr + i * dim,
+            stride_ptr + i * dim,
+            dim,
+            new_size_ptr + i * new_dim,
+            new_stride_ptr + i * new_dim)) {
+      return at::Tensor();
+    }
+  }
+  return wrap_buffer(
+      get_buffer(self),
+      EfficientSizeNode(degree, new_sizes),
+      EfficientSizeNode(
+          degree, new_strides, nested_stride.shared_storage_offsets()));
+}
+
 template <class F, class... A>
 inline at::Tensor map_nested_tensor(F&& fn, A... a) {
   // torch_check_tensor_shape_matches(a...);
@@ -299,6 +380,138 @@ inline at::Tensor map_nested_tensor(F&& fn, A... a) {
       map(std::forward<F>(fn), get_nested_tensor_structure(a)...));
 }
 
+// Constituent i of a NestedTensor of nested dimension 1. Regular Tensors are
+// broadcast, like in map.
+inline at::Tensor _constituent_or_broadcast(const TensorNode& node, int64_t i) {
+  if (node.is_leaf()) {
+    return node.payload();
+  }
+  return node.children(i).payload();
+}
+
+// The number of elements across all constituents of a NestedTensor, read off
+// its size table, or the number of elements of a regular Tensor.
+inline int64_t _total_numel(const at::Tensor& tensor) {
+  if (is_nested_tensor_impl(tensor)) {
+    return get_efficient_nested_size(tensor).numel();
+  }
+  return tensor.numel();
+}
+
+template <class F, size_t N, size_t... I>
+inline auto _call_on_constituents(
+    F& fn,
+    const std::array<TensorNode, N>& nodes,
+    int64_t i,
+    std::index_sequence<I...>) {
+  std::array<at::Tensor, N> args = {_constituent_or_broadcast(nodes[I], i)...};
+  return fn(args[I]...);
+}
+
+// Decides whether to split the constituents of CPU NestedTensors across the
+// intra-op thread pool and if so with what grain size, counted in
+// constituents. Each task should
+// contain about at::internal::GRAIN_SIZE elements. If there are fewer
+// constituents than threads and each of them is large enough we're better
+// off letting ATen parallelize within each op instead. NestedTensors that
+// differ in their number of constituents, including empty ones, are left to
+// map and apply, which broadcast or reject them.
+template <size_t N>
+inline bool _parallel_plan(
+    const std::array<TensorNode, N>& nodes,
+    const std::array<int64_t, N>& numels,
+    int64_t& degree,
+    int64_t& grain_size) {
+  if (at::in_parallel_region() || at::get_num_threads() == 1) {
+    return false;
+  }
+  degree = -1;
+  int64_t numel = 0;
+  for (size_t k = 0; k < N; k++) {
+    const TensorNode& node = nodes[k];
+    if (node.height() > 1) {
+      return false;
+    }
+    if (node.is_leaf()) {
+      if (!node.payload().device().is_cpu()) {
+        return false;
+      }
+      continue;
+    }
+    if (degree >= 0 && (int64_t)(node.degree()) != degree) {
+      return false;
+    }
+    degree = node.degree();
+    if (degree > 0 && !node.children(0).payload().device().is_cpu()) {
+      return false;
+    }
+    numel = std::max<int64_t>(numel, numels[k]);
+  }
+  if (degree < 2) {
+    return false;
+  }
+  const int64_t avg_numel = std::max<int64_t>(numel / degree, 1);
+  if (avg_numel >= at::internal::GRAIN_SIZE &&
+      degree < at::get_num_threads()) {
+    return false;
+  }
+  grain_size = std::max<int64_t>(at::internal::GRAIN_SIZE / avg_numel, 1);
+  return degree > grain_size;
+}
+
+// Like map_nested_tensor, but runs fn for different constituents in parallel
+// on the intra-op thread pool. fn must be safe to call concurrently. ATen ops
+// called from within fn run single threaded, since at::parallel_for doesn't
+// nest. Falls back to map_nested_tensor if parallelism isn't worthwhile.
+template <class F, class... A>
+inline at::Tensor parallel_map_nested_tensor(F&& fn, A... a) {
+  std::array<TensorNode, sizeof...(A)> nodes = {
+      get_nested_tensor_structure(a)...};
+  std::array<int64_t, sizeof...(A)> numels = {_total_numel(a)...};
+  int64_t degree = 0;
+  int64_t grain_size = 0;
+  if (!_parallel_plan(nodes, numels, degree, grain_size)) {
+    return map_nested_tensor(std::forward<F>(fn), a...);
+  }
+  std::vector<at::Tensor> results(degree);
+  at::ThreadLocalState state;
+  at::parallel_for(0, degree, grain_size, [&](int64_t begin, int64_t end) {
+    at::ThreadLocalStateGuard guard(state);
+    for (int64_t i = begin; i < end; i++) {
+      results[i] = _call_on_constituents(
+          fn, nodes, i, std::index_sequence_for<A...>());
+    }
+  });
+  std::vector<TensorNode> result_nodes;
+  result_nodes.reserve(degree);
+  for (int64_t i = 0; i < degree; i++) {
+    result_nodes.emplace_back(TensorNode(std::move(results[i])));
+  }
+  return wrap_tensor_node(TensorNode(std::move(result_nodes)));
+}
+
+// Parallel version of apply_nested_tensor. See parallel_map_nested_tensor.
+template <class F, class... A>
+inline void parallel_apply_nested_tensor(F&& fn, A... a) {
+  std::array<TensorNode, sizeof...(A)> nodes = {
+      get_nested_tensor_structure(a)...};
+  std::array<int64_t, sizeof...(A)> numels = {_total_numel(a)...};
+  int64_t degree = 0;
+  int64_t grain_size = 0;
+  if (!_parallel_plan(nodes, numels, degree, grain_size)) {
+    apply_nested_tensor(std::forward<F>(fn), a...);
+    return;
+  }
+  at::ThreadLocalState state;
+  at::parallel_for(0, degree, grain_size, [&](int64_t begin, int64_t end) {
+    at::ThreadLocalStateGuard guard(state);
+    for (int64_t i = begin; i < end; i++) {
+      _call_on_constituents(
+          fn, nodes, i, std::index_sequence_for<A...>());
+    }
+  });
+}
+
 template <class F, class I, class... A>
 inline typename c10::guts::infer_function_traits<F>::type::return_type
 reduce_nested_tensor(F&& fn, I init, A... a) {
@@ -307,6 +520,15 @@ reduce_nested_tensor(F&& fn, I init, A... a) {
   return reduce(std::forward<F>(fn), init, get_nested_tensor_structure(a)...);
 }
 
+// Calls fn(i, view) for each constituent of the given NestedTensor without
+// creating any at::Tensor views. See ConstituentView.
+template <class F>
+inline void for_each_constituent(F&& fn, const at::Tensor& tensor) {
+  auto impl = get_nested_tensor_impl(tensor);
+  torch::nested_tensor::impl::for_each_constituent(
+      std::forward<F>(fn), impl->get_nested_size(), impl->get_nested_stride());
+}
+
 inline std::vector<at::Tensor> flatten_nested_tensor(at::Tensor tensor) {
   return flatten(get_nested_tensor_structure(tensor));
 }
@@ -323,6 +545,20 @@ inline bool is_tensor_shape(const at::Tensor tensor) {
 
 Tensor NestedTensor_to_tensor(Tensor tensor, c10::optional<int64_t> dim_);
 
+// Resizes a contiguous CPU NestedTensor of [C, H, W] images with nearest
+// neighbor or bilinear interpolation in a single batched kernel.
+// output_sizes holds either one (height, width) pair for all images or one
+// pair per image. If it is empty, the output sizes are computed from the
+// scale factors scales_h and scales_w. Returns an undefined Tensor if the
+// input isn't supported.
+Tensor NestedTensor_upsample2d_cpu(
+    const Tensor& input,
+    const std::vector<int64_t>& output_sizes,
+    c10::optional<double> scales_h,
+    c10::optional<double> scales_w,
+    bool bilinear,
+    bool align_corners);
+
 inline Tensor NestedTensor_to_sparse_csr(Tensor tensor) {
   TORCH_CHECK(
       get_dim(tensor) == 2,
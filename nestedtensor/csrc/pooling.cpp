@@ -1,3 +1,5 @@
+#include <ATen/native/Pool.h>
+#include <nestedtensor/csrc/cpu/pooling.h>
 #include <nestedtensor/csrc/nested_tensor_impl.h>
 #include <nestedtensor/csrc/utils/nested_node_functions.h>
 #include <torch/extension.h>
@@ -9,10 +11,122 @@ namespace F = torch::nn::functional;
 
 namespace at {
 
+namespace {
+
+// Pools a contiguous or channels last CPU NestedTensor of images with
+// regular channels straight from its buffer into a packed output of the
+// same memory format. output_size(height, width, output_height,
+// output_width) computes the output size of an image and returns false if
+// the image isn't supported. kernel(input, output, images, num_images,
+// channels, channels_last) is called with the dtype of the input as its
+// template argument. Returns an undefined Tensor if the input isn't
+// supported.
+template <typename F, typename G>
+Tensor _pool2d_cpu(const Tensor& self, const F& output_size, const G& kernel) {
+  if (get_nested_dim(self) != 1 || get_dim(self) != 4) {
+    return Tensor();
+  }
+  Tensor buffer = get_buffer(self);
+  const ScalarType dtype = buffer.scalar_type();
+  if (!buffer.is_cpu() ||
+      !(dtype == kFloat || dtype == kDouble || dtype == kBFloat16)) {
+    return Tensor();
+  }
+  const bool contiguous = get_is_contiguous(self);
+  const bool channels_last = !contiguous &&
+      get_is_contiguous(self, c10::MemoryFormat::ChannelsLast);
+  auto opt_sizes = get_opt_sizes(self);
+  if ((!contiguous && !channels_last) || !opt_sizes[1]) {
+    return Tensor();
+  }
+  const int64_t channels = *opt_sizes[1];
+  EfficientSizeNode nested_size = get_efficient_nested_size(self);
+  const int64_t degree = nested_size.degree();
+  if (degree == 0) {
+    return Tensor();
+  }
+  const int64_t* sizes_ptr = nested_size.sizes().data_ptr<int64_t>();
+  const std::vector<int64_t>& offsets = nested_size.offsets();
+  std::vector<::nested_tensor::cpu::PoolImage> images(degree);
+  int64_t output_numel = 0;
+  for (int64_t i = 0; i < degree; i++) {
+    ::nested_tensor::cpu::PoolImage& image = images[i];
+    image.input_offset = offsets[i];
+    image.height = sizes_ptr[i * 3 + 1];
+    image.width = sizes_ptr[i * 3 + 2];
+    if (!output_size(
+            image.height,
+            image.width,
+            image.output_height,
+            image.output_width)) {
+      return Tensor();
+    }
+    image.output_offset = output_numel;
+    output_numel += channels * image.output_height * image.output_width;
+  }
+  int64_t i = 0;
+  EfficientSizeNode result_size = map_efficient_size(
+      [&images, &i](int64_t* size_ptr, int64_t size) {
+        size_ptr[1] = images[i].output_height;
+        size_ptr[2] = images[i].output_width;
+        i++;
+      },
+      nested_size);
+  Tensor output = empty_buffer(output_numel, buffer.options());
+  AT_DISPATCH_FLOATING_TYPES_AND(kBFloat16, dtype, "NestedTensor_pool2d", [&] {
+    kernel(
+        buffer.data_ptr<scalar_t>(),
+        output.data_ptr<scalar_t>(),
+        images.data(),
+        degree,
+        channels,
+        channels_last);
+  });
+  if (!channels_last) {
+    return wrap_buffer(std::move(output), result_size);
+  }
+  EfficientSizeNode result_stride = map_efficient_size(
+      [](int64_t* size_ptr, int64_t size) {
+        const int64_t channels = size_ptr[0];
+        size_ptr[1] = size_ptr[2] * channels;
+        size_ptr[2] = channels;
+        size_ptr[0] = 1;
+      },
+      result_size);
+  return wrap_buffer(std::move(output), result_size, result_stride);
+}
+
+} // namespace
+
 Tensor NestedTensor_adaptive_avg_pool2d(
     at::Tensor const& input,
     IntArrayRef output_size) {
-  return map_nested_tensor(
+  if (output_size.size() == 2 && output_size[0] > 0 && output_size[1] > 0) {
+    Tensor result = _pool2d_cpu(
+        input,
+        [&output_size](
+            int64_t height,
+            int64_t width,
+            int64_t& output_height,
+            int64_t& output_width) {
+          output_height = output_size[0];
+          output_width = output_size[1];
+          return height > 0 && width > 0;
+        },
+        [](auto* input,
+           auto* output,
+           const ::nested_tensor::cpu::PoolImage* images,
+           int64_t num_images,
+           int64_t channels,
+           bool channels_last) {
+          ::nested_tensor::cpu::adaptive_avg_pool2d_kernel(
+              input, output, images, num_images, channels, channels_last);
+        });
+    if (result.defined()) {
+      return result;
+    }
+  }
+  return parallel_map_nested_tensor(
       [&output_size](at::Tensor input) {
         return at::native::adaptive_avg_pool2d(input, output_size);
       },
@@ -22,7 +136,7 @@ Tensor NestedTensor_adaptive_avg_pool2d(
 Tensor NestedTensor_adaptive_avg_pool2d_backward(
     const Tensor& gradInput,
     const Tensor& input) {
-  return map_nested_tensor(
+  return parallel_map_nested_tensor(
       [](at::Tensor gradInput, at::Tensor input) {
         return at::_adaptive_avg_pool2d_backward(gradInput, input);
       },
@@ -38,6 +152,71 @@ Tensor NestedTensor_max_pool2d(
     IntArrayRef dilation,
     bool ceil_mode) {
   TORCH_CHECK(get_dim(self) == 4, "Input must be 4 dimensional.");
+  // Parameters are expanded as in ATen. Invalid ones are left to the
+  // fallback, which reports them.
+  if ((kernel_size.size() == 1 || kernel_size.size() == 2) &&
+      (stride.size() <= 2) && (padding.size() == 1 || padding.size() == 2) &&
+      (dilation.size() == 1 || dilation.size() == 2)) {
+    ::nested_tensor::cpu::ConvParams params;
+    params.kernel_h = kernel_size[0];
+    params.kernel_w = kernel_size.size() == 1 ? kernel_size[0] : kernel_size[1];
+    params.stride_h = stride.empty() ? params.kernel_h : stride[0];
+    params.stride_w = stride.empty() ? params.kernel_w
+        : stride.size() == 1         ? stride[0]
+                                     : stride[1];
+    params.pad_h = padding[0];
+    params.pad_w = padding.size() == 1 ? padding[0] : padding[1];
+    params.dilation_h = dilation[0];
+    params.dilation_w = dilation.size() == 1 ? dilation[0] : dilation[1];
+    if (params.kernel_h > 0 && params.kernel_w > 0 && params.stride_h > 0 &&
+        params.stride_w > 0 && params.dilation_h > 0 &&
+        params.dilation_w > 0 && params.pad_h >= 0 && params.pad_w >= 0 &&
+        params.pad_h <= params.kernel_h / 2 &&
+        params.pad_w <= params.kernel_w / 2) {
+      Tensor result = _pool2d_cpu(
+          self,
+          [&params, ceil_mode](
+              int64_t height,
+              int64_t width,
+              int64_t& output_height,
+              int64_t& output_width) {
+            output_height = at::native::pooling_output_shape<int64_t>(
+                height,
+                params.kernel_h,
+                params.pad_h,
+                params.stride_h,
+                params.dilation_h,
+                ceil_mode);
+            output_width = at::native::pooling_output_shape<int64_t>(
+                width,
+                params.kernel_w,
+                params.pad_w,
+                params.stride_w,
+                params.dilation_w,
+                ceil_mode);
+            return output_height > 0 && output_width > 0;
+          },
+          [&params](
+              auto* input,
+              auto* output,
+              const ::nested_tensor::cpu::PoolImage* images,
+              int64_t num_images,
+              int64_t channels,
+              bool channels_last) {
+            ::nested_tensor::cpu::max_pool2d_kernel(
+                input,
+                output,
+                images,
+                num_images,
+                channels,
+                params,
+                channels_last);
+          });
+      if (result.defined()) {
+        return result;
+      }
+    }
+  }
   if (self.dtype() == torch::kFloat16) {
     at::Tensor data = to_padded_tensor(self, 0);
     at::Tensor result_data = at::max_pool2d(data,
@@ -56,7 +235,7 @@ Tensor NestedTensor_max_pool2d(
     }
     return result;
   }
-  return map_nested_tensor(
+  return parallel_map_nested_tensor(
       [&](at::Tensor t) {
         return at::max_pool2d(
                    t.unsqueeze(0),
@@ -29,10 +29,8 @@ Tensor get_item(Tensor tensor, py::none key) {
   return wrap_tensor_node(TensorNode(std::move(result_nodes)));
 }
 
-at::Tensor get_item(Tensor tensor, int64_t key_) {
-  std::vector<at::Tensor> unbound = unbind(tensor, 0);
-  int64_t key = at::maybe_wrap_dim(key_, unbound.size());
-  return unbound[key];
+at::Tensor get_item(Tensor tensor, int64_t key) {
+  return at::select(tensor, 0, key);
 }
 
 #if (PYBIND11_VERSION_MAJOR >= 2 && PYBIND11_VERSION_MINOR >= 3)
@@ -189,6 +187,21 @@ TORCH_LIBRARY(nestedtensor, m) {
     return get_is_contiguous(self, memory_format);
   });
 
+  m.def("get_buffer(Tensor self) -> Tensor");
+  m.impl("get_buffer", NestedTensorKey, [](Tensor self) {
+    return get_buffer(self);
+  });
+
+  m.def("get_nested_size_tensor(Tensor self) -> Tensor");
+  m.impl("get_nested_size_tensor", NestedTensorKey, [](Tensor self) {
+    return get_efficient_nested_size(self).sizes();
+  });
+
+  m.def("get_nested_stride_tensor(Tensor self) -> Tensor");
+  m.impl("get_nested_stride_tensor", NestedTensorKey, [](Tensor self) {
+    return get_efficient_nested_stride(self).sizes();
+  });
+
   m.def("transpose_nhwc_nchw(Tensor self) -> Tensor");
   m.impl("transpose_nhwc_nchw", NestedTensorKey, [](Tensor self) {
     return transpose_nhwc_nchw(self);
@@ -222,6 +235,9 @@ PYBIND11_MODULE(TORCH_EXTENSION_NAME, m) {
   // via unbind.
 
   m.def("nested_tensor_impl", &torch::nested_tensor::nested_tensor_impl);
+  m.def(
+      "nested_tensor_from_buffer",
+      &torch::nested_tensor::nested_tensor_from_buffer);
 
   // Need to overwrite because
   // https://github.com/pytorch/pytorch/blob/09660896c0dd2bec888857300a7be9edb52dd05d/aten/src/ATen/TensorIndexing.h#L480
@@ -272,5 +288,8 @@ PYBIND11_MODULE(TORCH_EXTENSION_NAME, m) {
     return _nested_helper(index, get_nested_stride(self));
   });
 
+  m.def("arena_enter", []() { Arena::get().enter(); });
+  m.def("arena_exit", []() { Arena::get().exit(); });
+
   add_functions(m);
 }
@@ -73,6 +73,40 @@ at::Tensor interpolate(
         "Unexpected mode for interpolate: " + mode.value());
   }
 
+  // Nearest and bilinear resizing of contiguous CPU images runs as a single
+  // batched kernel. Arguments ATen rejects, such as align_corners in nearest
+  // mode or a size with a single element, are left to F::interpolate.
+  const bool bilinear = mode.value() == "bilinear";
+  const bool nearest = mode.value() == "nearest" || mode.value() == "none";
+  if (bilinear || (nearest && !align_corners.has_value())) {
+    std::vector<int64_t> output_sizes;
+    c10::optional<double> scales_h;
+    c10::optional<double> scales_w;
+    if (scale_factor.has_value()) {
+      scales_h = scale_factor.value()[0];
+      scales_w = scale_factor.value()[scale_factor.value().size() - 1];
+    } else if (size.has_value()) {
+      for (const std::vector<int64_t>& size_i : size.value()) {
+        if (size_i.size() != 2) {
+          output_sizes.clear();
+          break;
+        }
+        output_sizes.push_back(size_i[0]);
+        output_sizes.push_back(size_i[1]);
+      }
+    }
+    at::Tensor result = at::NestedTensor_upsample2d_cpu(
+        input,
+        output_sizes,
+        scales_h,
+        scales_w,
+        bilinear,
+        align_corners.value_or(false));
+    if (result.defined()) {
+      return result;
+    }
+  }
+
   auto options = F::InterpolateFuncOptions().mode(int_mode);
   if (align_corners.has_value()) {
     options.align_corners() = align_corners.value();
@@ -1,3 +1,6 @@
+#include <ATen/InferSize.h>
+#include <ATen/TensorUtils.h>
+#include <c10/util/accumulate.h>
 #include <nestedtensor/csrc/nested_tensor_impl.h>
 #include <nestedtensor/csrc/utils/nested_node_functions.h>
 #include <torch/extension.h>
@@ -8,6 +11,37 @@ namespace F = torch::nn::functional;
 
 namespace at {
 
+namespace {
+
+// Views every constituent of self as target_shape, which may contain -1,
+// by rewriting the nested sizes and strides. Returns an undefined Tensor if
+// a constituent can't be viewed without a copy.
+Tensor _view_constituents(const Tensor& self, IntArrayRef target_shape) {
+  return view_nested_tensor(
+      [&target_shape](
+          const int64_t* size,
+          const int64_t* stride,
+          int64_t dim,
+          int64_t* new_size,
+          int64_t* new_stride) {
+        IntArrayRef size_ref(size, dim);
+        std::vector<int64_t> shape =
+            at::infer_size(target_shape, c10::multiply_integers(size_ref));
+        auto strides = at::detail::computeStride(
+            size_ref, IntArrayRef(stride, dim), shape);
+        if (!strides) {
+          return false;
+        }
+        std::copy(shape.begin(), shape.end(), new_size);
+        std::copy(strides->begin(), strides->end(), new_stride);
+        return true;
+      },
+      self,
+      target_shape.size());
+}
+
+} // namespace
+
 Tensor NestedTensor_view(const Tensor& self, IntArrayRef size) {
   auto self_data = get_nested_tensor_impl(self);
   TORCH_CHECK(
@@ -20,7 +54,15 @@ Tensor NestedTensor_view(const Tensor& self, IntArrayRef size) {
   for (int64_t i = nested_dim; i < int64_t(size.size()); i++) {
     target_shape.push_back(size[i]);
   }
-  // TODO: Potential use for packed view, but requires custom backward.
+  if (self_data->get_nested_size().degree() > 0) {
+    Tensor result = _view_constituents(self, target_shape);
+    TORCH_CHECK(
+        result.defined(),
+        "view size is not compatible with input tensor's size and stride (at "
+        "least one dimension spans across two contiguous subspaces). Use "
+        ".reshape(...) instead.");
+    return result;
+  }
   return map_nested_tensor(
       [target_shape](const at::Tensor t) {
         return at::native::view(t, IntArrayRef(target_shape));
@@ -40,7 +82,14 @@ Tensor NestedTensor_reshape(const Tensor& self, IntArrayRef size) {
   for (int64_t i = nested_dim; i < int64_t(size.size()); i++) {
     target_shape.push_back(size[i]);
   }
-  // TODO: Potential use for packed reshape, but requires custom backward.
+  if (self_data->get_nested_size().degree() > 0) {
+    // Like at::reshape, this only copies if a view isn't possible.
+    Tensor result = _view_constituents(self, target_shape);
+    if (!result.defined()) {
+      result = _view_constituents(NestedTensor_contiguous(self), target_shape);
+    }
+    return result;
+  }
   return map_nested_tensor(
       [target_shape](const at::Tensor t) {
         return at::reshape(t, IntArrayRef(target_shape));
@@ -0,0 +1,141 @@
+#pragma once
+#include <ATen/ATen.h>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace torch {
+namespace nested_tensor {
+
+// A per-thread bump allocator for the packed buffers and metadata tables of
+// NestedTensors on CPU. While an arena scope is open, empty_buffer carves
+// allocations out of a few large slabs instead of going to the allocator
+// for every op.
+//
+// Memory is never reused within a scope. When the outermost scope closes,
+// the allocations that are still alive, e.g. the outputs of the scope, are
+// copied out into memory of their own, so they remain valid without pinning
+// a slab. Only the largest slab is kept for the next scope and only if it
+// is large enough for everything allocated in the previous one, so a steady
+// workload settles on a single slab.
+class Arena {
+ public:
+  static Arena& get() {
+    static thread_local Arena arena;
+    return arena;
+  }
+
+  bool active() const {
+    return _depth > 0;
+  }
+
+  void enter() {
+    _depth++;
+  }
+
+  void exit() {
+    TORCH_CHECK(_depth > 0, "Exiting an arena scope that was never entered.");
+    _depth--;
+    if (_depth == 0) {
+      _reset();
+    }
+  }
+
+  // Returns an uninitialized, contiguous 1-dim Tensor of numel elements.
+  at::Tensor allocate(int64_t numel, const at::TensorOptions& options) {
+    const int64_t nbytes = _aligned(
+        numel * static_cast<int64_t>(options.dtype().itemsize()));
+    if (_slabs.empty() || _used + nbytes > _slabs.back().numel()) {
+      _grow(nbytes);
+    }
+    at::Tensor slab = _slabs.back();
+    void* data = static_cast<uint8_t*>(slab.data_ptr()) + _used;
+    _used += nbytes;
+    _scope_bytes += nbytes;
+    at::Tensor result = at::from_blob(
+        data, {numel}, [slab](void* /* unused */) {}, options);
+    _allocations.emplace_back(result.storage().getIntrusivePtr());
+    return result;
+  }
+
+ private:
+  static constexpr int64_t kAlignment = 64;
+  static constexpr int64_t kMinSlabBytes = 1 << 20;
+
+  static int64_t _aligned(int64_t nbytes) {
+    return (nbytes + kAlignment - 1) / kAlignment * kAlignment;
+  }
+
+  void _grow(int64_t nbytes) {
+    const int64_t min_slab_bytes = kMinSlabBytes;
+    const int64_t slab_bytes =
+        std::max(std::max(nbytes, _next_slab_bytes), min_slab_bytes);
+    _slabs.push_back(at::empty({slab_bytes}, at::kByte));
+    _used = 0;
+    _next_slab_bytes = 2 * slab_bytes;
+  }
+
+  void _reset() {
+    // Moving an allocation out of its slab releases its reference to it, so
+    // afterwards the slabs are only referenced by _slabs.
+    for (const auto& allocation : _allocations) {
+      c10::intrusive_ptr<c10::StorageImpl> storage = allocation.lock();
+      if (!storage) {
+        continue;
+      }
+      const size_t nbytes = storage->nbytes();
+      at::DataPtr data = c10::GetCPUAllocator()->allocate(nbytes);
+      if (nbytes > 0) {
+        std::memcpy(data.get(), storage->data_ptr().get(), nbytes);
+      }
+      storage->set_data_ptr(std::move(data));
+    }
+    _allocations.clear();
+    at::Tensor reusable;
+    for (const at::Tensor& slab : _slabs) {
+      if (!reusable.defined() || slab.numel() > reusable.numel()) {
+        reusable = slab;
+      }
+    }
+    _slabs.clear();
+    if (reusable.defined() && reusable.numel() >= _scope_bytes) {
+      _slabs.push_back(std::move(reusable));
+    }
+    _next_slab_bytes = _scope_bytes;
+    _scope_bytes = 0;
+    _used = 0;
+  }
+
+  int64_t _depth = 0;
+  std::vector<at::Tensor> _slabs;
+  std::vector<c10::weak_intrusive_ptr<c10::StorageImpl>> _allocations;
+  int64_t _used = 0;
+  int64_t _scope_bytes = 0;
+  int64_t _next_slab_bytes = 0;
+};
+
+// Returns an uninitialized, contiguous 1-dim Tensor of numel elements for
+// the packed buffer or metadata of a NestedTensor. It is taken from the
+// arena of the current thread if an arena scope is open and the Tensor is
+// an ordinary CPU Tensor.
+inline at::Tensor empty_buffer(
+    int64_t numel,
+    const at::TensorOptions& options) {
+  Arena& arena = Arena::get();
+  if (arena.active() && options.device().is_cpu() &&
+      options.layout() == at::kStrided && !options.pinned_memory()) {
+    return arena.allocate(numel, options);
+  }
+  return at::empty({numel}, options);
+}
+
+// Returns a contiguous copy of tensor, see empty_buffer.
+inline at::Tensor clone_buffer(const at::Tensor& tensor) {
+  at::Tensor result =
+      empty_buffer(tensor.numel(), tensor.options()).view(tensor.sizes());
+  result.copy_(tensor);
+  return result;
+}
+
+} // namespace nested_tensor
+} // namespace torch
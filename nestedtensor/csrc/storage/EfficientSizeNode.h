@@ -1,5 +1,9 @@
 #pragma once
+#include <nestedtensor/csrc/storage/Arena.h>
 #include <nestedtensor/csrc/storage/common.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
 
 namespace torch {
 namespace nested_tensor {
@@ -30,7 +34,9 @@ inline std::vector<c10::optional<int64_t>> construct_efficient_size(
   std::vector<c10::optional<int64_t>> result;
   result.push_back(out);
   size_t nested_dim = result.size();
-  if (sizes.dim() > 0) {
+  if (sizes.dim() > 0 && sizes.size(0) == 0) {
+    result.resize(nested_dim + sizes.size(1));
+  } else if (sizes.dim() > 0) {
     int64_t* sizes_ptr = sizes.data_ptr<int64_t>();
     result.resize(nested_dim + sizes.size(1));
     for (int64_t i = 0; i < sizes.size(1); i++) {
@@ -48,13 +54,67 @@ inline std::vector<c10::optional<int64_t>> construct_efficient_size(
   return result;
 }
 
+// Whether a NestedTensor with given nested sizes and strides is laid out
+// contiguously, given that its buffer is contiguous and not empty.
+struct NestedLayout {
+  bool is_contiguous;
+  bool is_contiguous_channels_last;
+};
+
+// Metadata derived from the sizes that is expensive enough to be worth
+// computing only once. It is filled in lazily on first use and shared by all
+// copies of an EfficientSizeNode, since copies share the same sizes Tensor.
+struct EfficientSizeTable {
+  std::mutex mutex;
+  std::atomic<bool> valid{false};
+  // offsets[i] is the offset of constituent i within a packed buffer and
+  // offsets[degree] is the total number of elements.
+  std::vector<int64_t> offsets;
+  // Incremented whenever the sizes are modified in place.
+  std::atomic<int64_t> version{0};
+  // Only set for nodes of strides. The layout for the sizes described by
+  // layout_sizes at version layout_version, see
+  // EfficientSizeNode::cached_layout.
+  std::weak_ptr<EfficientSizeTable> layout_sizes;
+  int64_t layout_version = 0;
+  NestedLayout layout;
+};
+
+inline void fill_offsets(
+    std::vector<int64_t>& offsets,
+    int64_t structure,
+    const at::Tensor& sizes) {
+  offsets.clear();
+  if (sizes.dim() == 0) {
+    // Constituents are scalars.
+    offsets.resize(structure + 1);
+    for (int64_t i = 0; i <= structure; i++) {
+      offsets[i] = i;
+    }
+    return;
+  }
+  const int64_t degree = sizes.size(0);
+  const int64_t width = sizes.size(1);
+  const int64_t* sizes_ptr = sizes.data_ptr<int64_t>();
+  offsets.resize(degree + 1);
+  offsets[0] = 0;
+  for (int64_t i = 0; i < degree; i++) {
+    int64_t numel = 1;
+    for (int64_t j = 0; j < width; j++) {
+      numel = numel * sizes_ptr[i * width + j];
+    }
+    offsets[i + 1] = offsets[i] + numel;
+  }
+}
+
 } // namespace impl
 
 struct EfficientSizeNode {
   explicit EfficientSizeNode(const SizeNode& size_node)
       : _structure(size_node.degree()),
         _sizes(impl::stack_sizes(size_node)),
-        _opt_sizes(impl::construct_efficient_size(_structure, _sizes))
+        _opt_sizes(impl::construct_efficient_size(_structure, _sizes)),
+        _table(std::make_shared<impl::EfficientSizeTable>())
   {}
 
   explicit EfficientSizeNode(
@@ -62,7 +122,23 @@ struct EfficientSizeNode {
       const at::Tensor& sizes)
       : _structure(structure),
         _sizes(sizes),
-        _opt_sizes(impl::construct_efficient_size(_structure, _sizes))
+        _opt_sizes(impl::construct_efficient_size(_structure, _sizes)),
+        _table(std::make_shared<impl::EfficientSizeTable>())
+  {}
+
+  // A node of strides for constituents that aren't packed one after another,
+  // e.g. of a view that selects some of the constituents of another
+  // NestedTensor. storage_offsets[i] is the offset of constituent i within
+  // the buffer.
+  explicit EfficientSizeNode(
+      int64_t structure,
+      const at::Tensor& sizes,
+      std::shared_ptr<const std::vector<int64_t>> storage_offsets)
+      : _structure(structure),
+        _sizes(sizes),
+        _opt_sizes(impl::construct_efficient_size(_structure, _sizes)),
+        _table(std::make_shared<impl::EfficientSizeTable>()),
+        _storage_offsets(std::move(storage_offsets))
   {}
 
   SizeNode to_size_node() const {
@@ -100,6 +176,12 @@ struct EfficientSizeNode {
   }
   void refresh_opt_sizes() {
     _opt_sizes = impl::construct_efficient_size(_structure, _sizes);
+    // The sizes were modified in place, which also affects all copies of this
+    // node, so the shared table is invalidated rather than replaced.
+    std::lock_guard<std::mutex> guard(_table->mutex);
+    _table->valid.store(false, std::memory_order_release);
+    _table->version.fetch_add(1, std::memory_order_acq_rel);
+    _table->layout_sizes.reset();
   }
   const at::Tensor& sizes() const {
     return _sizes;
@@ -108,33 +190,70 @@ struct EfficientSizeNode {
     return _structure;
   }
   EfficientSizeNode clone() const {
-    return EfficientSizeNode(_structure, _sizes.clone());
+    return EfficientSizeNode(_structure, clone_buffer(_sizes), _storage_offsets);
   }
-  int64_t numel() const {
-    if (_sizes.dim() == 0 && _structure > 0) {
-      return _structure;
-    }
-    if (_sizes.dim() > 0) {
-      if (_sizes.numel() == 0) {
-        return 0;
-      }
-      Tensor nt_sizes = at::native::narrow(
-          _sizes, 1 /* dim */, 0 /* start */, 1 /* length */);
-      for (int64_t i = 1; i < _sizes.size(1); i++) {
-        Tensor tmp = at::native::narrow(
-            _sizes, 1 /* dim */, i /* start */, 1 /* length */);
-        nt_sizes = nt_sizes * tmp;
+  // The explicit offsets of the constituents within the buffer if this is a
+  // node of strides that has them and nullptr otherwise, in which case the
+  // constituents are packed and their offsets are given by the offsets of
+  // the node of sizes.
+  const std::vector<int64_t>* storage_offsets() const {
+    return _storage_offsets.get();
+  }
+  const std::shared_ptr<const std::vector<int64_t>>& shared_storage_offsets()
+      const {
+    return _storage_offsets;
+  }
+  // Offsets of each constituent within a packed buffer, followed by the
+  // total number of elements. Has degree() + 1 entries.
+  const std::vector<int64_t>& offsets() const {
+    if (!_table->valid.load(std::memory_order_acquire)) {
+      std::lock_guard<std::mutex> guard(_table->mutex);
+      if (!_table->valid.load(std::memory_order_relaxed)) {
+        impl::fill_offsets(_table->offsets, _structure, _sizes);
+        _table->valid.store(true, std::memory_order_release);
       }
-      return nt_sizes.sum().item<int64_t>();
     }
-    return 0;
+    return _table->offsets;
+  }
+  int64_t numel(int64_t i) const {
+    const std::vector<int64_t>& offsets_ = offsets();
+    return offsets_[i + 1] - offsets_[i];
+  }
+  int64_t numel() const {
+    return offsets().back();
+  }
+  // The layout of a NestedTensor with sizes nested_size and this node as its
+  // strides, if it was recorded by cache_layout. Since NestedTensors that
+  // share metadata share the table, this lets e.g. the result of an
+  // elementwise op skip scanning the sizes and strides again.
+  bool cached_layout(
+      const EfficientSizeNode& nested_size,
+      impl::NestedLayout& layout) const {
+    std::lock_guard<std::mutex> guard(_table->mutex);
+    if (_table->layout_sizes.lock() != nested_size._table ||
+        _table->layout_version !=
+            nested_size._table->version.load(std::memory_order_acquire)) {
+      return false;
+    }
+    layout = _table->layout;
+    return true;
+  }
+  void cache_layout(
+      const EfficientSizeNode& nested_size,
+      impl::NestedLayout layout) const {
+    std::lock_guard<std::mutex> guard(_table->mutex);
+    _table->layout_sizes = nested_size._table;
+    _table->layout_version =
+        nested_size._table->version.load(std::memory_order_acquire);
+    _table->layout = layout;
   }
 
  private:
   int64_t _structure;
   const at::Tensor _sizes;
-  bool _opt_sizes_set = false;
   std::vector<c10::optional<int64_t>> _opt_sizes;
+  std::shared_ptr<impl::EfficientSizeTable> _table;
+  std::shared_ptr<const std::vector<int64_t>> _storage_offsets;
 };
 
 inline bool efficient_size_structure_matches(
@@ -158,15 +277,17 @@ template <class F>
 inline EfficientSizeNode map_efficient_size(
     F&& fn,
     const EfficientSizeNode& size_node) {
-  at::Tensor sizes = size_node.sizes().clone();
+  at::Tensor sizes = clone_buffer(size_node.sizes());
   if (sizes.dim() == 0) {
-    return EfficientSizeNode(size_node.structure(), sizes);
+    return EfficientSizeNode(
+        size_node.structure(), sizes, size_node.shared_storage_offsets());
   }
   int64_t* sizes_ptr = sizes.data_ptr<int64_t>();
   for (int64_t i = 0; i < sizes.size(0); i++) {
     fn(sizes_ptr + i * sizes.size(1), sizes.size(1));
   }
-  return EfficientSizeNode(size_node.structure(), sizes);
+  return EfficientSizeNode(
+      size_node.structure(), sizes, size_node.shared_storage_offsets());
 }
 
 template <class F>
@@ -177,11 +298,12 @@ inline EfficientSizeNode map_efficient_size(
   TORCH_CHECK(
       efficient_size_structure_matches(size_node0, size_node1),
       "map_efficient_size: Length doesn't match.");
-  at::Tensor sizes0 = size_node0.sizes().clone();
-  at::Tensor sizes1 = size_node1.sizes().clone();
+  at::Tensor sizes0 = clone_buffer(size_node0.sizes());
+  at::Tensor sizes1 = clone_buffer(size_node1.sizes());
   TORCH_CHECK(sizes0.dim() == sizes1.dim(), "Sizes need to match in dim.");
   if (sizes0.dim() == 0) {
-    return EfficientSizeNode(size_node0.structure(), sizes0);
+    return EfficientSizeNode(
+        size_node0.structure(), sizes0, size_node0.shared_storage_offsets());
   }
   TORCH_CHECK(sizes0.size(0) == sizes1.size(0), "Sizes need to match in size(0).");
   TORCH_CHECK(sizes0.size(1) == sizes1.size(1), "Sizes need to match in size(1).");
@@ -190,7 +312,8 @@ inline EfficientSizeNode map_efficient_size(
   for (int64_t i = 0; i < sizes0.size(0); i++) {
     fn(sizes_ptr0 + i * sizes0.size(1), sizes_ptr1 + i * sizes1.size(1), sizes0.size(1));
   }
-  return EfficientSizeNode(size_node0.structure(), sizes0);
+  return EfficientSizeNode(
+      size_node0.structure(), sizes0, size_node0.shared_storage_offsets());
 }
 
 template <class F>
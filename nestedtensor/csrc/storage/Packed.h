@@ -7,6 +7,74 @@ namespace torch {
 namespace nested_tensor {
 namespace impl {
 
+inline bool strides_are_contiguous(
+    const EfficientSizeNode& nested_size,
+    const EfficientSizeNode& nested_stride) {
+  const at::Tensor& sizes_sizes = nested_size.sizes();
+  const at::Tensor& strides_sizes = nested_stride.sizes();
+  if (sizes_sizes.dim() == 0) {
+    return true;
+  }
+  int64_t* sizes_sizes_ptr = sizes_sizes.data_ptr<int64_t>();
+  int64_t* strides_sizes_ptr = strides_sizes.data_ptr<int64_t>();
+  for (int64_t i = 0; i < sizes_sizes.size(0); i++) {
+    if (!_is_cont_stride(
+            sizes_sizes_ptr + i * sizes_sizes.size(1),
+            strides_sizes_ptr + i * strides_sizes.size(1),
+            sizes_sizes.size(1))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+inline bool strides_are_channels_last(
+    const EfficientSizeNode& nested_size,
+    const EfficientSizeNode& nested_stride) {
+  if (nested_size.dim() != 4) {
+    return false;
+  }
+  const at::Tensor& sizes_sizes = nested_size.sizes();
+  const at::Tensor& strides_sizes = nested_stride.sizes();
+  int64_t* sizes_sizes_ptr = sizes_sizes.data_ptr<int64_t>();
+  int64_t* strides_sizes_ptr = strides_sizes.data_ptr<int64_t>();
+  std::vector<int64_t> sizes(4, 0);
+  std::vector<int64_t> strides(4, 0);
+  for (int64_t i = 0; i < sizes_sizes.size(0); i++) {
+    sizes[0] = 1;
+    sizes[1] = sizes_sizes_ptr[i * 3 + 0];
+    sizes[2] = sizes_sizes_ptr[i * 3 + 1];
+    sizes[3] = sizes_sizes_ptr[i * 3 + 2];
+    strides[0] = sizes_sizes_ptr[i * 3 + 0] *
+                 sizes_sizes_ptr[i * 3 + 1] *
+                 sizes_sizes_ptr[i * 3 + 2];
+    strides[1] = strides_sizes_ptr[i * 3 + 0];
+    strides[2] = strides_sizes_ptr[i * 3 + 1];
+    strides[3] = strides_sizes_ptr[i * 3 + 2];
+    if (!c10::is_channels_last_strides_2d(IntArrayRef(sizes), IntArrayRef(strides))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Scans the sizes and strides once per stride node and caches the result on
+// it, so NestedTensors constructed from the metadata of another NestedTensor
+// can look up their layout in constant time.
+inline NestedLayout nested_layout(
+    const EfficientSizeNode& nested_size,
+    const EfficientSizeNode& nested_stride) {
+  NestedLayout layout;
+  if (nested_stride.cached_layout(nested_size, layout)) {
+    return layout;
+  }
+  layout.is_contiguous = strides_are_contiguous(nested_size, nested_stride);
+  layout.is_contiguous_channels_last =
+      strides_are_channels_last(nested_size, nested_stride);
+  nested_stride.cache_layout(nested_size, layout);
+  return layout;
+}
+
 inline EfficientSizeNode _cont_stride(const EfficientSizeNode& nested_size) {
   auto nested_stride = map_efficient_size(
       [](int64_t* size_ptr, int64_t size) {
@@ -15,51 +83,130 @@ inline EfficientSizeNode _cont_stride(const EfficientSizeNode& nested_size) {
           size_ptr[i] = cont_stride[i];
         }
       }, nested_size);
+  // These strides are contiguous by construction.
+  NestedLayout layout;
+  layout.is_contiguous = true;
+  layout.is_contiguous_channels_last =
+      strides_are_channels_last(nested_size, nested_stride);
+  nested_stride.cache_layout(nested_size, layout);
   return nested_stride;
 }
 
+// Describes a single constituent of a NestedTensor by its position within
+// the buffer and pointers into the nested size and stride tables. Unlike the
+// at::Tensor views created by build_structure this doesn't allocate, so it is
+// what kernels should use to walk over the constituents.
+struct ConstituentView {
+  int64_t offset;
+  int64_t numel;
+  int64_t dim;
+  const int64_t* sizes;
+  const int64_t* strides;
+
+  c10::IntArrayRef size_ref() const {
+    return c10::IntArrayRef(sizes, dim);
+  }
+  c10::IntArrayRef stride_ref() const {
+    return c10::IntArrayRef(strides, dim);
+  }
+};
+
+inline ConstituentView constituent_view(
+    const EfficientSizeNode& nested_size,
+    const EfficientSizeNode& nested_stride,
+    int64_t i) {
+  const std::vector<int64_t>& offsets = nested_size.offsets();
+  const std::vector<int64_t>* storage_offsets = nested_stride.storage_offsets();
+  const at::Tensor& sizes = nested_size.sizes();
+  const at::Tensor& strides = nested_stride.sizes();
+  const int64_t width = sizes.dim() > 0 ? sizes.size(1) : 0;
+  ConstituentView view;
+  view.offset = storage_offsets ? (*storage_offsets)[i] : offsets[i];
+  view.numel = offsets[i + 1] - offsets[i];
+  view.dim = width;
+  view.sizes = sizes.data_ptr<int64_t>() + i * width;
+  view.strides = strides.data_ptr<int64_t>() + i * width;
+  return view;
+}
+
+// Calls fn(i, view) for each constituent i.
+template <class F>
+inline void for_each_constituent(
+    F&& fn,
+    const EfficientSizeNode& nested_size,
+    const EfficientSizeNode& nested_stride) {
+  TORCH_CHECK(
+      efficient_size_structure_matches(nested_size, nested_stride),
+      "for_each_constituent: Length doesn't match.");
+  const at::Tensor& sizes = nested_size.sizes();
+  if (sizes.dim() == 0) {
+    return;
+  }
+  const at::Tensor& strides = nested_stride.sizes();
+  const std::vector<int64_t>& offsets = nested_size.offsets();
+  const std::vector<int64_t>* storage_offsets = nested_stride.storage_offsets();
+  const int64_t width = sizes.size(1);
+  const int64_t* sizes_ptr = sizes.data_ptr<int64_t>();
+  const int64_t* strides_ptr = strides.data_ptr<int64_t>();
+  ConstituentView view;
+  view.dim = width;
+  for (int64_t i = 0; i < sizes.size(0); i++) {
+    view.offset = storage_offsets ? (*storage_offsets)[i] : offsets[i];
+    view.numel = offsets[i + 1] - offsets[i];
+    view.sizes = sizes_ptr + i * width;
+    view.strides = strides_ptr + i * width;
+    fn(i, view);
+  }
+}
+
+// Calls fn(i, data, view) for each constituent i, where data points to the
+// first element of the constituent within the given buffer.
+template <class scalar_t, class F>
+inline void for_each_constituent(
+    F&& fn,
+    const at::Tensor& buffer,
+    const EfficientSizeNode& nested_size,
+    const EfficientSizeNode& nested_stride) {
+  scalar_t* data = buffer.data_ptr<scalar_t>();
+  for_each_constituent(
+      [&fn, data](int64_t i, const ConstituentView& view) {
+        fn(i, data + view.offset, view);
+      },
+      nested_size,
+      nested_stride);
+}
+
+// Materializes a single constituent as an at::Tensor view into buffer.
+inline at::Tensor constituent(
+    const at::Tensor& buffer,
+    const ConstituentView& view) {
+  return at::as_strided(
+      buffer,
+      view.size_ref(),
+      view.stride_ref(),
+      buffer.storage_offset() + view.offset);
+}
+
 inline std::tuple<TensorNode, at::Tensor> build_structure(
     const at::Tensor& buffer,
     const EfficientSizeNode& nested_size_,
     const EfficientSizeNode& nested_stride_) {
   TORCH_CHECK(
       buffer.dim() == 1, "Given buffer must be vector, i.e. dim 1 Tensor.");
-  std::vector<int64_t> split_sizes;
-  split_sizes.reserve(nested_size_.degree());
-  map_efficient_size([&split_sizes] (int64_t* sizes_ptr0, int64_t* sizes_ptr1, int64_t size) {
-      split_sizes.push_back(num_memory(sizes_ptr0, sizes_ptr1, size));
-      }, nested_size_, nested_stride_);
-  std::vector<int64_t> nonzero_split_sizes;
-  for (size_t i = 0; i < split_sizes.size(); i++) {
-    if (split_sizes[i] > 0) {
-      nonzero_split_sizes.push_back(split_sizes[i]);
-    }
-  }
-  std::vector<at::Tensor> buffers_;
-  if (nonzero_split_sizes.size() > 0) {
-    buffers_ =
-        at::split_with_sizes(buffer, c10::IntArrayRef(nonzero_split_sizes), 0);
-  }
-  std::vector<at::Tensor> buffers;
-  int64_t index = 0;
-  for (size_t i = 0; i < split_sizes.size(); i++) {
-    if (split_sizes[i] > 0) {
-      buffers.push_back(buffers_[index]);
-      index++;
-    } else {
-      buffers.push_back(at::empty({}, buffer.options()));
-    }
-  }
+  // Views with explicit offsets may refer to a constituent more than once.
+  TORCH_CHECK(
+      nested_stride_.storage_offsets() ||
+          nested_size_.numel() <= buffer.numel(),
+      "Given buffer of numel ", buffer.numel(),
+      " is too small for nested size of numel ", nested_size_.numel(), ".");
   std::vector<TensorNode> result_tensors;
-  index = 0;
-  map_efficient_size([&buffers, &result_tensors, &index](
-        int64_t* size_ptr, int64_t* stride_ptr, int64_t size) {
-      std::vector<int64_t> sizes(size_ptr, size_ptr + size);
-      std::vector<int64_t> strides(stride_ptr, stride_ptr + size);
-      result_tensors.push_back(TensorNode(at::as_strided(
-            buffers[index], c10::IntArrayRef(sizes), c10::IntArrayRef(strides))));
-      index++;
-      }, nested_size_, nested_stride_);
+  result_tensors.reserve(nested_size_.degree());
+  for_each_constituent(
+      [&buffer, &result_tensors](int64_t i, const ConstituentView& view) {
+        result_tensors.push_back(TensorNode(constituent(buffer, view)));
+      },
+      nested_size_,
+      nested_stride_);
   return std::make_tuple(TensorNode(std::move(result_tensors)), buffer);
 }
 
@@ -107,19 +254,10 @@ inline bool storage_is_contiguous(
   if (buffer.numel() == 0) {
     return true;
   }
-  const at::Tensor& sizes_sizes = nested_size.sizes();
-  const at::Tensor& strides_sizes = nested_stride.sizes();
-  int64_t* sizes_sizes_ptr = sizes_sizes.data_ptr<int64_t>();
-  int64_t* strides_sizes_ptr = strides_sizes.data_ptr<int64_t>();
-  for (int64_t i = 0; i < sizes_sizes.size(0); i++) {
-    if (!_is_cont_stride(
-            sizes_sizes_ptr + i * sizes_sizes.size(1),
-            strides_sizes_ptr + i * strides_sizes.size(1),
-            sizes_sizes.size(1))) {
-      return false;
-    }
+  if (nested_stride.storage_offsets()) {
+    return false;
   }
-  return true;
+  return nested_layout(nested_size, nested_stride).is_contiguous;
 }
 
 inline bool storage_is_contiguous_channels_last(
@@ -132,31 +270,10 @@ inline bool storage_is_contiguous_channels_last(
   if (buffer.numel() == 0) {
     return true;
   }
-  if (nested_size.dim() != 4) {
+  if (nested_stride.storage_offsets()) {
     return false;
   }
-  const at::Tensor& sizes_sizes = nested_size.sizes();
-  const at::Tensor& strides_sizes = nested_stride.sizes();
-  int64_t* sizes_sizes_ptr = sizes_sizes.data_ptr<int64_t>();
-  int64_t* strides_sizes_ptr = strides_sizes.data_ptr<int64_t>();
-  std::vector<int64_t> sizes(4, 0);
-  std::vector<int64_t> strides(4, 0);
-  for (int64_t i = 0; i < sizes_sizes.size(0); i++) {
-    sizes[0] = 1;
-    sizes[1] = sizes_sizes_ptr[i * 3 + 0];
-    sizes[2] = sizes_sizes_ptr[i * 3 + 1];
-    sizes[3] = sizes_sizes_ptr[i * 3 + 2];
-    strides[0] = sizes_sizes_ptr[i * 3 + 0] *
-                 sizes_sizes_ptr[i * 3 + 1] *
-                 sizes_sizes_ptr[i * 3 + 2];
-    strides[1] = strides_sizes_ptr[i * 3 + 0];
-    strides[2] = strides_sizes_ptr[i * 3 + 1];
-    strides[3] = strides_sizes_ptr[i * 3 + 2];
-    if (!c10::is_channels_last_strides_2d(IntArrayRef(sizes), IntArrayRef(strides))) {
-      return false;
-    }
-  }
-  return true;
+  return nested_layout(nested_size, nested_stride).is_contiguous_channels_last;
 }
 
 } // namespace impl
@@ -1,5 +1,6 @@
 
 #include <ATen/ATen.h>
+#include <algorithm>
 #include <ATen/NamedTensorUtils.h>
 #include <ATen/WrapDimUtils.h>
 #include <ATen/core/op_registration/op_registration.h>
@@ -13,23 +14,59 @@ namespace at {
 using namespace torch::nested_tensor;
 using namespace c10;
 
-at::Tensor _to_tensor(TensorNode node) {
-  // TODO: Recursive stacking is expensive.
-  if (node.is_leaf()) {
-    return node.payload();
+// Converts a NestedTensor of nested dimension 1 whose constituents all have
+// size new_size[1:] without stacking. If the constituents are packed
+// contiguously the result is a view of the buffer. If they are equally
+// strided and spaced within the buffer it is a single strided copy that
+// preserves their layout, e.g. channels last. Otherwise each constituent is
+// copied into its slot of the result.
+at::Tensor _to_tensor_regular(
+    NestedTensorImpl* nt_impl,
+    const std::vector<int64_t>& new_size) {
+  const at::Tensor& buffer = nt_impl->get_buffer();
+  EfficientSizeNode nested_size = nt_impl->get_nested_size();
+  EfficientSizeNode nested_stride = nt_impl->get_nested_stride();
+  const int64_t degree = nested_size.degree();
+  if (degree == 0) {
+    return at::empty({0}, buffer.options());
   }
-  if (node.degree() == 0) {
-    return at::empty({0});
+  if (nt_impl->get_is_contiguous(MemoryFormat::Contiguous) &&
+      buffer.numel() == nested_size.numel()) {
+    return buffer.reshape(IntArrayRef(new_size));
   }
-  std::vector<at::Tensor> flat;
-  for (auto child : node.unbind()) {
-    flat.push_back(_to_tensor(child));
+  const int64_t tensor_dim = nested_size.sizes().size(1);
+  const int64_t* strides_ptr = nested_stride.sizes().data_ptr<int64_t>();
+  const std::vector<int64_t>* storage_offsets = nested_stride.storage_offsets();
+  const std::vector<int64_t>& offsets =
+      storage_offsets ? *storage_offsets : nested_size.offsets();
+  const int64_t step = degree > 1 ? offsets[1] - offsets[0] : nested_size.numel(0);
+  bool regular = step >= 0;
+  for (int64_t i = 1; i < degree && regular; i++) {
+    regular = offsets[i] - offsets[0] == i * step &&
+        std::equal(
+                  strides_ptr,
+                  strides_ptr + tensor_dim,
+                  strides_ptr + i * tensor_dim);
   }
-  return stack(flat);
+  if (regular) {
+    std::vector<int64_t> new_stride(strides_ptr, strides_ptr + tensor_dim);
+    new_stride.insert(new_stride.begin(), step);
+    at::Tensor flat = buffer.reshape({-1});
+    return at::as_strided(
+               flat,
+               IntArrayRef(new_size),
+               IntArrayRef(new_stride),
+               flat.storage_offset() + offsets[0])
+        .clone(MemoryFormat::Preserve);
+  }
+  at::Tensor result = at::empty(IntArrayRef(new_size), buffer.options());
+  for (int64_t i = 0; i < degree; i++) {
+    result.select(0, i).copy_(nt_impl->constituent(i));
+  }
+  return result;
 }
 
 at::Tensor to_tensor(NestedTensorImpl* nt_impl) {
-  // TODO: Not necessarily a view because of stack and reshape.
   std::vector<int64_t> new_size;
   for (const auto& si : nt_impl->opt_sizes()) {
     if (!si) {
@@ -40,7 +77,7 @@ at::Tensor to_tensor(NestedTensorImpl* nt_impl) {
     }
     new_size.push_back(*si);
   }
-  return _to_tensor(nt_impl->get_structure());
+  return _to_tensor_regular(nt_impl, new_size);
 }
 
 Tensor NestedTensor_to_tensor(Tensor tensor, c10::optional<int64_t> dim_) {
@@ -48,43 +85,13 @@ Tensor NestedTensor_to_tensor(Tensor tensor, c10::optional<int64_t> dim_) {
     return NestedTensor_to_tensor(tensor, 0);
   }
   int64_t dim = maybe_wrap_dim((*dim_), get_dim(tensor));
-  if (dim != 0) {
-    TORCH_CHECK(false, "Non-zero dimension ", *dim_, " is currently not supported.");
-  }
-  std::vector<int64_t> new_size;
   auto impl_data = get_nested_tensor_impl(tensor);
-  for (const auto& si : impl_data->opt_sizes()) {
-    if (!si) {
-      // TODO: This assumes we'll extend to_tensor to also work with int64_t
-      // at this level.
-      throw std::out_of_range(
-          "to_tensor()/to_tensor(0) only works if there is no None in size().");
-    }
-    new_size.push_back(*si);
+  // If dim is at least nested_dim the NestedTensor already consists of
+  // Tensors for all dimensions from dim on.
+  if (dim >= impl_data->nested_dim()) {
+    return tensor;
   }
-  return _to_tensor(impl_data->get_structure());
-  // // If dim is bigger than nested_dim the NestedTensor is already
-  // // of Tensor for dimensions bigger than the given.
-  // if (impl_data->nested_dim() == 1) {
-  //   return tensor;
-  // }
-  // // At this point nested_dim is at least 2. That means any unbind
-  // // operation of a child must yield NestedTensors.
-  // // If dim is 1 then we'll apply to_tensor(0) to the children and must expect
-  // // Tensors.
-  // std::vector<at::Tensor> unbound = at::unbind(tensor, 0);
-  // std::vector<TensorNode> result;
-  // for (Tensor child : unbound) {
-  //   auto ci = NestedTensor_to_tensor(child, dim - 1);
-  //   if (is_nested_tensor_impl(ci)) {
-  //     auto s = get_nested_tensor_impl(ci)->get_structure();
-  //     result.push_back(TensorNode(std::move(s)));
-  //   } else {
-  //     // TODO: If it's a NestedTensor instance get the structure
-  //     result.push_back(TensorNode(std::move(ci)));
-  //   }
-  // }
-  // return wrap_tensor_node(TensorNode(std::move(result)));
+  return to_tensor(impl_data);
 }
 
 TORCH_LIBRARY_FRAGMENT(nestedtensor, m) {
@@ -1,3 +1,4 @@
+#include <nestedtensor/csrc/cpu/transpose.h>
 #include <nestedtensor/csrc/nested_tensor_impl.h>
 #include <nestedtensor/csrc/utils/nested_node_functions.h>
 #include <torch/extension.h>
@@ -46,34 +47,39 @@ Tensor _collapse_two_dims(Tensor input, int64_t dim1, int64_t dim2) {
 template <int grain_size>
 std::tuple<at::Tensor, at::Tensor> _create_offsets(Tensor input) {
   TORCH_CHECK(get_dim(input) == 3, "Expected input to be 3 dimensional.");
-  Tensor nt_sizes = get_efficient_nested_size(input).sizes();
+  auto esize = get_efficient_nested_size(input);
+  Tensor nt_sizes = esize.sizes();
+  const std::vector<int64_t>& esize_offsets = esize.offsets();
   int64_t* nt_sizes_ptr = nt_sizes.data_ptr<int64_t>();
   int64_t batch_size = nt_sizes.size(0);
-  at::Tensor offsets = torch::empty({1 + batch_size}, torch::kInt32);
-  at::Tensor block_offsets = torch::empty({1 + batch_size}, torch::kInt32);
-  int* offsets_ptr = offsets.data_ptr<int>();
-  int* block_offsets_ptr = block_offsets.data_ptr<int>();
+  at::Tensor offsets = torch::empty({1 + batch_size}, torch::kInt64);
+  at::Tensor block_offsets = torch::empty({1 + batch_size}, torch::kInt64);
+  int64_t* offsets_ptr = offsets.data_ptr<int64_t>();
+  int64_t* block_offsets_ptr = block_offsets.data_ptr<int64_t>();
   offsets_ptr[0] = 0;
   block_offsets_ptr[0] = 0;
   int64_t index = 1;
   for (int64_t i = 0; i < batch_size; i++) {
     int64_t size1 = nt_sizes_ptr[i * 2 + 0];
     int64_t size2 = nt_sizes_ptr[i * 2 + 1];
-    const int num_chunks_1 = (size1 + grain_size - 1) / grain_size;
-    const int num_chunks_2 = (size2 + grain_size - 1) / grain_size;
-    offsets_ptr[index] = offsets_ptr[index - 1] + (int)(size1 * size2);
+    const int64_t num_chunks_1 = (size1 + grain_size - 1) / grain_size;
+    const int64_t num_chunks_2 = (size2 + grain_size - 1) / grain_size;
+    offsets_ptr[index] = esize_offsets[index];
     block_offsets_ptr[index] = block_offsets_ptr[index - 1] + num_chunks_1 * num_chunks_2;
     index++;
   }
   return std::make_tuple(offsets, block_offsets);
 }
 
-std::vector<Tensor> _transfer_metadata(std::vector<Tensor> meta_tensors) {
+// Copies the given metadata to device as int32 in a single transfer.
+std::vector<Tensor> _transfer_metadata(
+    std::vector<Tensor> meta_tensors,
+    at::Device device) {
   for (size_t i = 0; i < meta_tensors.size(); i++) {
     meta_tensors[i] = meta_tensors[i].view(-1);
   }
   at::Tensor all_meta = at::cat(meta_tensors);
-  all_meta = all_meta.to(at::Device(kCUDA), torch::kInt32, true, true);
+  all_meta = all_meta.to(device, torch::kInt32, true, true);
   std::vector<Tensor> result_meta_tensors;
   int64_t index = 0;
   for (size_t i = 0; i < meta_tensors.size(); i++) {
@@ -86,24 +92,41 @@ std::vector<Tensor> _transfer_metadata(std::vector<Tensor> meta_tensors) {
 
 template <typename scalar_t>
 Tensor _transpose_nchw_nhwc(Tensor input, Tensor output) {
-#ifdef WITH_CUDA
   Tensor collapsed_input = _collapse_two_dims(input, 2, 3);
   Tensor nt_sizes = get_efficient_nested_size(collapsed_input).sizes();
   Tensor sizes_dim2 = at::native::narrow(nt_sizes, 1, 0, 1).contiguous();
   Tensor sizes_dim3 = at::native::narrow(nt_sizes, 1, 1, 1).contiguous();
+  int batch_size = sizes_dim2.numel();
+  if (batch_size == 0) {
+    return output;
+  }
   Tensor offsets;
   Tensor block_offsets;
   std::tie(offsets, block_offsets) = _create_offsets<32>(collapsed_input);
-  at::cuda::CUDAStream defaultStream = at::cuda::getDefaultCUDAStream();
   Tensor input_buffer = get_buffer(input);
   Tensor output_buffer = get_buffer(output);
+  int64_t* block_offsets_ptr = block_offsets.data_ptr<int64_t>();
+  if (input_buffer.is_cpu()) {
+    TORCH_CHECK(output_buffer.is_cpu(), "Expected output_buffer to be CPU.");
+    ::nested_tensor::cpu::transpose_kernel<scalar_t>(
+        input_buffer.data_ptr<scalar_t>(),
+        output_buffer.data_ptr<scalar_t>(),
+        offsets.data_ptr<int64_t>(),
+        block_offsets_ptr,
+        batch_size,
+        sizes_dim2[0].item<int64_t>(),
+        true,
+        32);
+    return output;
+  }
+#ifdef WITH_CUDA
+  at::cuda::CUDAStream defaultStream = at::cuda::getDefaultCUDAStream();
   TORCH_CHECK(input_buffer.is_cuda(), "Expected input_buffer to be CUDA.");
   TORCH_CHECK(output_buffer.is_cuda(), "Expected output_buffer to be CUDA.");
-  int* block_offsets_ptr = block_offsets.data_ptr<int>();
-  int batch_size = sizes_dim2.numel();
-  int block_numel = block_offsets_ptr[batch_size];
+  int block_numel = (int)(block_offsets_ptr[batch_size]);
   auto result_meta_tensors = _transfer_metadata({offsets,
-                                                 block_offsets});
+                                                 block_offsets},
+                                                input_buffer.device());
   nested_tensor::cuda::transpose_nchw_nhwc_kernelLauncher(
       input_buffer.data_ptr<scalar_t>(),
       output_buffer.data_ptr<scalar_t>(),
@@ -133,6 +156,12 @@ Tensor transpose_nchw_nhwc(Tensor input) {
       size_ptr[1] = tmp;
       }, get_efficient_nested_size(input));
   Tensor output = wrap_buffer(at::empty_like(input_buffer), new_sizes);
+  if (input_buffer.is_cpu()) {
+    return AT_DISPATCH_ALL_TYPES_AND3(
+        kHalf, kBFloat16, kBool, get_dtype(input), "transpose_nchw_nhwc", [&] {
+          return _transpose_nchw_nhwc<scalar_t>(input, output);
+        });
+  }
   if (get_dtype(input) == torch::kFloat16) {
     return _transpose_nchw_nhwc<c10::Half>(input, output);
   }
@@ -144,22 +173,39 @@ Tensor transpose_nchw_nhwc(Tensor input) {
 
 template <typename scalar_t>
 Tensor _transpose_nhwc_nchw(Tensor input, Tensor output) {
-#ifdef WITH_CUDA
   Tensor collapsed_input = _collapse_two_dims(input, 1, 2);
   Tensor nt_sizes = get_efficient_nested_size(collapsed_input).sizes();
   Tensor sizes_dim2 = at::native::narrow(nt_sizes, 1, 0, 1).contiguous();
   Tensor sizes_dim3 = at::native::narrow(nt_sizes, 1, 1, 1).contiguous();
+  int batch_size = sizes_dim3.numel();
+  if (batch_size == 0) {
+    return output;
+  }
   Tensor offsets;
   Tensor block_offsets;
   std::tie(offsets, block_offsets) = _create_offsets<32>(collapsed_input);
-  at::cuda::CUDAStream defaultStream = at::cuda::getDefaultCUDAStream();
   Tensor input_buffer = get_buffer(input);
   Tensor output_buffer = get_buffer(output);
-  int* block_offsets_ptr = block_offsets.data_ptr<int>();
-  int batch_size = sizes_dim3.numel();
-  int block_numel = block_offsets_ptr[batch_size];
+  int64_t* block_offsets_ptr = block_offsets.data_ptr<int64_t>();
+  if (input_buffer.is_cpu()) {
+    TORCH_CHECK(output_buffer.is_cpu(), "Expected output_buffer to be CPU.");
+    ::nested_tensor::cpu::transpose_kernel<scalar_t>(
+        input_buffer.data_ptr<scalar_t>(),
+        output_buffer.data_ptr<scalar_t>(),
+        offsets.data_ptr<int64_t>(),
+        block_offsets_ptr,
+        batch_size,
+        sizes_dim3[0].item<int64_t>(),
+        false,
+        32);
+    return output;
+  }
+#ifdef WITH_CUDA
+  at::cuda::CUDAStream defaultStream = at::cuda::getDefaultCUDAStream();
+  int block_numel = (int)(block_offsets_ptr[batch_size]);
   auto result_meta_tensors = _transfer_metadata({offsets,
-                                                 block_offsets});
+                                                 block_offsets},
+                                                input_buffer.device());
   nested_tensor::cuda::transpose_nhwc_nchw_kernelLauncher(
       input_buffer.data_ptr<scalar_t>(),
       output_buffer.data_ptr<scalar_t>(),
@@ -192,6 +238,12 @@ Tensor transpose_nhwc_nchw(Tensor input) {
       // nchw
       }, get_efficient_nested_size(input));
   Tensor output = wrap_buffer(at::empty_like(input_buffer), new_sizes);
+  if (input_buffer.is_cpu()) {
+    return AT_DISPATCH_ALL_TYPES_AND3(
+        kHalf, kBFloat16, kBool, get_dtype(input), "transpose_nhwc_nchw", [&] {
+          return _transpose_nhwc_nchw<scalar_t>(input, output);
+        });
+  }
   if (get_dtype(input) == torch::kFloat16) {
     return _transpose_nhwc_nchw<c10::Half>(input, output);
   }
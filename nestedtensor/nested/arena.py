@@ -0,0 +1,23 @@
+import contextlib
+
+import nestedtensor
+
+
+@contextlib.contextmanager
+def arena():
+    """
+    Allocates the buffers and metadata of NestedTensors created on CPU
+    within this context from a per-thread arena.
+
+    The arena grows to the total size of all allocations of a scope and is
+    reused by the next scope. This avoids going to the allocator for every op
+    of e.g. a batch in an inference loop. NestedTensors created within the
+    context remain valid after it exits, they are copied out of the arena
+    when the outermost scope exits, so it pays to let only the outputs of a
+    scope escape it. Scopes may be nested.
+    """
+    nestedtensor._C.arena_enter()
+    try:
+        yield
+    finally:
+        nestedtensor._C.arena_exit()
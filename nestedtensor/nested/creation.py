@@ -24,3 +24,20 @@ def as_nested_tensor(data, dtype=None, device=None, requires_grad=False, pin_mem
     if not isinstance(data, nested.NestedTensor):
         return nested_tensor(data, dtype, device, requires_grad, pin_memory)
     return data
+
+
+def nested_tensor_from_buffer(buffer, sizes, strides=None, dtype=None, device=None, requires_grad=False, pin_memory=False):
+    """
+    Wraps a flat buffer as a NestedTensor without copying it.
+
+    sizes is either a vector of lengths along the first dimension of buffer,
+    with the remaining dimensions shared by all constituents, or a matrix
+    with one row of sizes per constituent. In the latter case strides may
+    be given as a matrix of the same shape, otherwise the constituents are
+    packed contiguously one after another.
+
+    dtype and device default to those of buffer. The buffer is only copied if
+    it isn't contiguous, if it needs to be converted or if pin_memory is set.
+    """
+    return nested.NestedTensor(nestedtensor._C.nested_tensor_from_buffer(
+        buffer, sizes, strides, dtype, device, requires_grad, pin_memory))
@@ -22,6 +22,8 @@ def _nn_functional_linear(input, weight, bias=None):
     # in-place version, for which we don't have an op above autograd, since the custom
     # function wrapper autograd_map_nested_tensor doesn't support it.
     # And that's why we're writing our own version of linear here.
+    if torch.ops.nestedtensor.is_nested_tensor_impl(input):
+        return torch.ops.nestedtensor.linear(input, weight, bias)
     output = input.matmul(weight.t())
     if bias is not None:
         output = output + bias
@@ -183,6 +185,54 @@ def transpose_nhwc_nchw(tensor):
         torch.ops.nestedtensor.transpose_nhwc_nchw(tensor._impl))
 
 
+def masked_softmax(input, dim, mask=None, scale=1.0):
+    """
+    Computes softmax(scale * input + mask) along dim as a single fused
+    operation. mask is an additive mask of the same nested size as input.
+    """
+    return _wrap_result(
+        torch.ops.nestedtensor.masked_softmax(
+            input._impl, dim, None if mask is None else mask._impl, scale))
+
+
+def add_bias_layer_norm(input, residual, bias=None, weight=None, layer_bias=None, eps=1e-5):
+    """
+    Computes layer_norm(input + residual + bias) over the last dimension
+    as a single fused operation.
+    """
+    return _wrap_result(
+        torch.ops.nestedtensor.add_bias_layer_norm(
+            input._impl, residual._impl, bias, weight, layer_bias, eps))
+
+
+def linear(input, weight, bias=None, activation=None, residual=None):
+    """
+    Computes activation(input @ weight.T + bias) + residual as a single
+    fused operation. activation is one of None, "relu", "gelu" or "silu"
+    and residual is a NestedTensor of the same nested size as the output.
+    """
+    return _wrap_result(
+        torch.ops.nestedtensor.linear(
+            input._impl, weight, bias, "none" if activation is None else activation,
+            None if residual is None else residual._impl))
+
+
+def conv_bn_relu(input, weight, bias, running_mean, running_var, bn_weight=None,
+                 bn_bias=None, eps=1e-5, stride=1, padding=0, dilation=1,
+                 groups=1, relu=True):
+    """
+    Computes conv2d followed by batch_norm in inference mode and relu, with
+    the batch norm folded into the convolution.
+    """
+    def _pair(x):
+        return [x, x] if isinstance(x, int) else list(x)
+    return _wrap_result(
+        torch.ops.nestedtensor.conv_bn_relu(
+            input._impl, weight, bias, running_mean, running_var, bn_weight,
+            bn_bias, eps, _pair(stride), _pair(padding), _pair(dilation),
+            groups, relu))
+
+
 class NestedTensorMeta(type):
     def __getattr__(cls, name):
         if getattr(torch.Tensor, name):
@@ -0,0 +1,148 @@
+import json
+import os
+import struct
+
+import torch
+
+import nestedtensor
+
+# File layout
+#
+#   preamble   magic, format version and length of the header
+#   header     utf-8 encoded JSON, see save
+#   sections   sizes, strides, offsets and buffer, each starting at a
+#              multiple of _ALIGNMENT from the beginning of the file
+#
+# The sizes and strides are the [degree, tensor_dim] int64 tables of the
+# NestedTensor, offsets holds the degree + 1 int64 offsets of the
+# constituents within the buffer and buffer is the packed data itself.
+# Section offsets within the header are relative to the end of the header
+# rounded up to _ALIGNMENT.
+
+_MAGIC = b"NESTEDT\0"
+_VERSION = 1
+_ALIGNMENT = 64
+_PREAMBLE = struct.Struct("<8sIQ")
+_SECTIONS = ("sizes", "strides", "offsets", "buffer")
+
+
+def _aligned(nbytes):
+    return (nbytes + _ALIGNMENT - 1) // _ALIGNMENT * _ALIGNMENT
+
+
+def _as_bytes(tensor):
+    return tensor.contiguous().reshape(-1).view(torch.uint8).numpy()
+
+
+def save(nt, path):
+    """
+    Writes a NestedTensor of nested dimension 1 to path.
+
+    The buffer is written as is if the NestedTensor is contiguous or
+    contiguous in channels last format and packed contiguously otherwise,
+    so that every constituent occupies its own range of the buffer.
+    """
+    if not isinstance(nt, nestedtensor.NestedTensor):
+        raise TypeError("Expected a NestedTensor, got " + str(type(nt)) + ".")
+    if nt.nested_dim() != 1:
+        raise RuntimeError("Can only save NestedTensors of nested dimension 1.")
+    layout = "contiguous"
+    if nt.dim() == 4 and nt.is_contiguous(memory_format=torch.channels_last):
+        layout = "channels_last"
+    elif not nt.is_contiguous():
+        nt = nt.contiguous()
+    impl = nt.to(torch.device("cpu"))._impl
+    degree = len(nt)
+    tensor_dim = nt.dim() - 1
+
+    def table(tensor):
+        # The tables of an empty NestedTensor are scalars.
+        if degree == 0:
+            return torch.zeros(0, tensor_dim, dtype=torch.int64)
+        return tensor.reshape(degree, tensor_dim)
+
+    sizes = table(torch.ops.nestedtensor.get_nested_size_tensor(impl))
+    strides = table(torch.ops.nestedtensor.get_nested_stride_tensor(impl))
+    offsets = torch.cat([torch.zeros(1, dtype=torch.int64),
+                         sizes.prod(1).cumsum(0)])
+    buffer = torch.ops.nestedtensor.get_buffer(impl)[:int(offsets[-1])]
+
+    data = {"sizes": _as_bytes(sizes),
+            "strides": _as_bytes(strides),
+            "offsets": _as_bytes(offsets),
+            "buffer": _as_bytes(buffer)}
+    sections = {}
+    position = 0
+    for name in _SECTIONS:
+        sections[name] = [position, data[name].nbytes]
+        position = _aligned(position + data[name].nbytes)
+    header = json.dumps({
+        "dtype": str(nt.dtype).split(".")[-1],
+        "degree": degree,
+        "tensor_dim": tensor_dim,
+        "layout": layout,
+        "sections": sections,
+    }).encode("utf-8")
+    data_start = _aligned(_PREAMBLE.size + len(header))
+    with open(path, "wb") as f:
+        f.write(_PREAMBLE.pack(_MAGIC, _VERSION, len(header)))
+        f.write(header)
+        for name in _SECTIONS:
+            f.seek(data_start + sections[name][0])
+            f.write(data[name].data)
+        f.truncate(data_start + position)
+
+
+def _read_header(f):
+    preamble = f.read(_PREAMBLE.size)
+    if len(preamble) != _PREAMBLE.size:
+        raise RuntimeError("File is too short to be a NestedTensor.")
+    magic, version, header_size = _PREAMBLE.unpack(preamble)
+    if magic != _MAGIC:
+        raise RuntimeError("File is not a NestedTensor.")
+    if version != _VERSION:
+        raise RuntimeError("Unsupported NestedTensor file version " +
+                           str(version) + ".")
+    header = json.loads(f.read(header_size).decode("utf-8"))
+    return header, _aligned(_PREAMBLE.size + header_size)
+
+
+def load(path, start=None, stop=None, mmap=True):
+    """
+    Reads the constituents [start, stop) of a NestedTensor written by save.
+
+    If mmap is set, the file is mapped into memory and the result is built
+    on top of the mapped pages without copying its buffer, so only the
+    pages of the constituents that are accessed are read. The mapping is
+    private, i.e. modifying the result doesn't modify the file. Otherwise
+    only the requested constituents are copied into memory.
+    """
+    file_size = os.path.getsize(path)
+    with open(path, "rb") as f:
+        header, data_start = _read_header(f)
+    data = torch.from_file(path, shared=False, size=file_size,
+                           dtype=torch.uint8)
+    dtype = getattr(torch, header["dtype"])
+    degree = header["degree"]
+    tensor_dim = header["tensor_dim"]
+
+    def section(name, dtype):
+        offset, nbytes = header["sections"][name]
+        offset = data_start + offset
+        return data[offset:offset + nbytes].view(dtype)
+
+    start, stop, _ = slice(start, stop).indices(degree)
+    stop = max(start, stop)
+    offsets = section("offsets", torch.int64)
+    begin = int(offsets[start])
+    end = int(offsets[stop])
+    sizes = section("sizes", torch.int64).reshape(degree, tensor_dim)
+    sizes = sizes[start:stop]
+    strides = None
+    if header["layout"] != "contiguous":
+        strides = section("strides", torch.int64).reshape(degree, tensor_dim)
+        strides = strides[start:stop]
+    buffer = section("buffer", dtype)[begin:end]
+    if not mmap:
+        buffer = buffer.clone()
+    return nestedtensor.nested_tensor_from_buffer(buffer, sizes, strides)
@@ -100,6 +100,7 @@ def get_extensions():
     this_dir = os.path.dirname(os.path.abspath(__file__))
     extensions_dir = os.path.join(this_dir, "nestedtensor", "csrc")
     utils_dir = os.path.join(extensions_dir, "utils")
+    cpu_dir = os.path.join(extensions_dir, "cpu")
     cuda_dir = os.path.join(this_dir, "nestedtensor", "csrc", "cuda")
 
     extension_sources = set(
@@ -109,6 +110,9 @@ def get_extensions():
     utils_sources = set(
         os.path.join(utils_dir, p) for p in glob.glob(os.path.join(utils_dir, "*.cpp"))
     )
+    cpu_sources = set(
+        os.path.join(cpu_dir, p) for p in glob.glob(os.path.join(cpu_dir, "*.cpp"))
+    )
 
     if (torch.cuda.is_available() and CUDA_HOME is not None) or os.getenv(
         "FORCE_CUDA", "0"
@@ -119,9 +123,9 @@ def get_extensions():
         cuda_cpp_sources = set(
             os.path.join(cuda_dir, p) for p in glob.glob(os.path.join(cuda_dir, "*.cpp"))
         )
-        sources = list(set(extension_sources) | set(utils_sources) | set(cuda_sources) | set(cuda_cpp_sources))
+        sources = list(set(extension_sources) | set(utils_sources) | set(cpu_sources) | set(cuda_sources) | set(cuda_cpp_sources))
     else:
-        sources = list(set(extension_sources) | set(utils_sources))
+        sources = list(set(extension_sources) | set(utils_sources) | set(cpu_sources))
 
     include_dirs = [extensions_dir, utils_dir]
 
@@ -43,6 +43,21 @@ class TestNestedTensorBuffer(TestCase):
     def test_detach(self):
         pass
 
+    def test_arena(self):
+        tensors = [torch.randn(3, 4), torch.randn(5, 4)]
+        results = []
+        for _ in range(3):
+            with nestedtensor.arena():
+                nt = nestedtensor.nested_tensor(tensors)
+                with nestedtensor.arena():
+                    out = torch.nn.functional.layer_norm(nt + nt, (4,))
+                results.append(out.softmax(-1).sum(-1))
+        for result in results:
+            for r, t in zip(result.unbind(), tensors):
+                expected = torch.nn.functional.layer_norm(t + t, (4,))
+                self.assertEqual(r, expected.softmax(-1).sum(-1))
+        self.assertRaises(RuntimeError, lambda: nestedtensor._C.arena_exit())
+
 
 if __name__ == "__main__":
     unittest.main()
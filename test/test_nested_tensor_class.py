@@ -121,6 +121,61 @@ class TestNestedTensor(TestCase):
             self.assertEqual(default_nested_tensor.is_pinned(),
                              default_tensor.is_pinned())
 
+    def test_nested_tensor_from_buffer(self):
+        buffer = torch.randn(7, 4)
+        nt = nestedtensor.nested_tensor_from_buffer(
+            buffer, torch.tensor([2, 0, 5]))
+        self.assertEqual(nt.nested_size(0), 3)
+        self.assertEqual(nt.nested_size(1), (2, 0, 5))
+        self.assertEqual(nt.size(2), 4)
+        self.assertTrue(nt.is_contiguous())
+        for t, expected in zip(nt.unbind(), buffer.split([2, 0, 5])):
+            self.assertEqual(t, expected)
+        # The buffer is wrapped, not copied.
+        buffer.add_(1)
+        self.assertEqual(nt.unbind()[2], buffer[2:])
+
+        buffer = torch.arange(12.)
+        sizes = torch.tensor([[2, 3], [3, 2]])
+        nt = nestedtensor.nested_tensor_from_buffer(buffer, sizes)
+        self.assertEqual(nt.unbind()[0], buffer[:6].reshape(2, 3))
+        self.assertEqual(nt.unbind()[1], buffer[6:].reshape(3, 2))
+        strides = torch.tensor([[1, 2], [1, 3]])
+        nt = nestedtensor.nested_tensor_from_buffer(buffer, sizes, strides)
+        self.assertFalse(nt.is_contiguous())
+        self.assertEqual(nt.unbind()[0], buffer[:6].reshape(3, 2).t())
+        self.assertEqual(nt.unbind()[1], buffer[6:].reshape(2, 3).t())
+
+        nt = nestedtensor.nested_tensor_from_buffer(
+            buffer, sizes, dtype=torch.float64)
+        self.assertEqual(nt.dtype, torch.float64)
+        self.assertEqual(nt.unbind()[1], buffer[6:].reshape(3, 2).double())
+
+        self.assertRaises(RuntimeError, lambda: nestedtensor.nested_tensor_from_buffer(
+            buffer, torch.tensor([[2, 3], [3, 3]])))
+        self.assertRaises(RuntimeError, lambda: nestedtensor.nested_tensor_from_buffer(
+            buffer, torch.tensor([[2, -3], [3, 2]])))
+        self.assertRaises(RuntimeError, lambda: nestedtensor.nested_tensor_from_buffer(
+            buffer, sizes, torch.tensor([[1, 2], [1, 4]])))
+        self.assertRaises(RuntimeError, lambda: nestedtensor.nested_tensor_from_buffer(
+            buffer, sizes, torch.tensor([[1, 1], [1, 3]])))
+
+        # A buffer with slack is trimmed, so a contiguous result is packed.
+        nt = nestedtensor.nested_tensor_from_buffer(
+            torch.arange(16.), sizes, torch.tensor([[3, 1], [2, 1]]))
+        self.assertTrue(nt.is_contiguous())
+        self.assertEqual(
+            torch.ops.nestedtensor.get_buffer(nt._impl).numel(), 12)
+        self.assertEqual(nt.unbind()[1], buffer[6:].reshape(3, 2))
+        self.assertEqual(nt + 1, nestedtensor.nested_tensor_from_buffer(
+            buffer + 1, sizes))
+
+        nt = nestedtensor.nested_tensor_from_buffer(
+            torch.empty(0), torch.empty(0, 2, dtype=torch.int64))
+        self.assertEqual(nt.nested_size(0), 0)
+        self.assertEqual(nt.dim(), 3)
+        self.assertEqual(len(nt.unbind()), 0)
+
     # def test_scalar_constructor(self):
     #     # Not a valid NestedTensor. This is not a list of Tensors or constructables for Tensors.
     #     ntimeError, lambda: nestedtensor.nested_tensor([1.0]))
@@ -446,6 +501,47 @@ class TestNestedTensor(TestCase):
         _test_fn(lambda x, dim: x.unbind(dim))
         _test_fn(lambda x, dim: torch.unbind(x, dim))
 
+    def test_select(self):
+        a = torch.randn(2, 3)
+        b = torch.randn(4, 3)
+        nt = ntnt_nograd([a, b])
+        self.assertEqual(nt.select(0, 0), a)
+        self.assertEqual(nt.select(0, -1), b)
+        self.assertRaises(IndexError, lambda: nt.select(0, 2))
+        # Changing the metadata of a returned constituent must not
+        # affect the NestedTensor.
+        b1 = nt.select(0, 1)
+        b1.unsqueeze_(0)
+        self.assertEqual(nt.select(0, 1), b)
+        self.assertEqual(nt.unbind()[1], b)
+
+    def test_slice_index_select_view(self):
+        ts = [torch.randn(i + 1, 3) for i in range(5)]
+        buffer = torch.cat(ts)
+        nt = nestedtensor.nested_tensor_from_buffer(
+            buffer, torch.tensor([t.size(0) for t in ts]))
+        views = [(nt[1:4], ts[1:4]),
+                 (nt[::2], ts[::2]),
+                 (nt[4:], ts[4:]),
+                 (nt.index_select(0, torch.tensor([3, 0, 3])),
+                  [ts[3], ts[0], ts[3]])]
+        for view, expected in views:
+            self.assertEqual(view, ntnt_nograd(expected))
+        self.assertTrue(nt[1:4].is_contiguous())
+        self.assertFalse(nt[::2].is_contiguous())
+        # Views share the buffer of the NestedTensor.
+        buffer.mul_(2)
+        for view, expected in views:
+            self.assertEqual(view, ntnt_nograd([2 * t for t in expected]))
+        # Views of views and ops on views.
+        nested = nt.index_select(0, torch.tensor([4, 1, 2]))[1:]
+        self.assertEqual(nested, ntnt_nograd([2 * ts[1], 2 * ts[2]]))
+        self.assertEqual(nested + 1, ntnt_nograd([2 * ts[1] + 1, 2 * ts[2] + 1]))
+        self.assertEqual(nested.contiguous(), ntnt_nograd([2 * ts[1], 2 * ts[2]]))
+        self.assertEqual(nt[::2][1], 2 * ts[2])
+        self.assertEqual(len(nt[3:1]), 0)
+        self.assertRaises(IndexError, lambda: nt.index_select(0, torch.tensor([5])))
+
     def test_size(self):
         for constructor in _iter_constructors():
             a = constructor([])
@@ -545,6 +641,27 @@ class TestNestedTensor(TestCase):
             # self.assertRaises(RuntimeError, lambda: a.to_tensor(3))
             # self.assertRaises(IndexError, lambda: a.to_tensor(4))
 
+    def test_to_tensor_regular(self):
+        tensors = [torch.randn(3, 2, 4) for _ in range(5)]
+        result = torch.stack(tensors)
+
+        nt = ntnt_nograd(tensors)
+        data = nt.to_tensor()
+        self.assertEqual(data, result)
+        self.assertEqual(data.data_ptr(), nt[0].data_ptr())
+        self.assertEqual(nt.to_tensor(1), nt)
+        self.assertEqual(nt.to_tensor(-1), nt)
+
+        nt = ntnt_nograd(tensors, channels_last=True)
+        data = nt.to_tensor()
+        self.assertEqual(data, result)
+        self.assertTrue(data.is_contiguous(memory_format=torch.channels_last))
+
+        nt = ntnt_nograd(tensors).index_select(0, torch.tensor([4, 0, 4]))
+        self.assertEqual(nt.to_tensor(), torch.stack(
+            [tensors[4], tensors[0], tensors[4]]))
+        self.assertEqual(ntnt_nograd(tensors)[1:].to_tensor(), result[1:])
+
     def test_to_nested_tensor(self):
         for constructor in _iter_constructors():
             a = constructor([])
@@ -737,6 +854,34 @@ class TestNestedTensor(TestCase):
             [nt0, nt1], dim=2),
             ntnt_nograd([torch.stack([a, c], dim=1), b.reshape(3, 1, 4)]))
 
+    def test_cat_stack_packed(self):
+        ts0 = [torch.randn(2, 3), torch.randn(4, 5)]
+        ts1 = [torch.randn(2, 1), torch.randn(4, 2)]
+        ts2 = [torch.randn(3, 3), torch.randn(1, 5)]
+        nt0, nt1, nt2 = ntnt_nograd(ts0), ntnt_nograd(ts1), ntnt_nograd(ts2)
+        self.assertEqual(torch.cat([nt0, nt2, nt0], dim=0),
+                         ntnt_nograd(ts0 + ts2 + ts0))
+        for dim in [2, -1]:
+            self.assertEqual(torch.cat([nt0, nt1, nt0], dim=dim),
+                             ntnt_nograd([torch.cat([a, b, a], dim=1)
+                                          for (a, b) in zip(ts0, ts1)]))
+        self.assertEqual(torch.cat([nt0, nt2], dim=1),
+                         ntnt_nograd([torch.cat([a, b])
+                                      for (a, b) in zip(ts0, ts2)]))
+        for dim in [1, 2, 3]:
+            self.assertEqual(torch.stack([nt0, nt0 * 2], dim=dim),
+                             ntnt_nograd([torch.stack([a, a * 2], dim=dim - 1)
+                                          for a in ts0]))
+        # Inputs that aren't packed and other dtypes.
+        view = ntnt_nograd(ts0 + ts2)[::2]
+        self.assertEqual(torch.cat([view, nt1], dim=0),
+                         ntnt_nograd([ts0[0], ts2[0]] + ts1))
+        ints = [torch.arange(6).reshape(2, 3), torch.arange(4).reshape(4, 1)]
+        nt = ntnt_nograd(ints)
+        self.assertEqual(torch.cat([nt, nt], dim=2),
+                         ntnt_nograd([torch.cat([t, t], dim=1) for t in ints]))
+        self.assertRaises(RuntimeError, lambda: torch.cat([nt0, nt1], dim=1))
+
     @unittest.skip("sparse csr currently broken")
     def test_to_sparse_csr(self):
         a = torch.arange(3) + 1
@@ -751,6 +896,24 @@ class TestNestedTensor(TestCase):
                                "Given tensor must be of dimension 2, got dimension 3",
                                lambda: nt.to_sparse_csr_tensor())
 
+    def test_to_padded_tensor_cpu(self):
+        import random
+        random.seed(1010)
+        shapes = [[(random.randint(3, 30),) for _ in range(5)],
+                  [(random.randint(3, 30), random.randint(3, 30)) for _ in range(5)],
+                  [(random.randint(3, 30), 7) for _ in range(5)],
+                  [(random.randint(3, 10),
+                    random.randint(3, 10),
+                    random.randint(3, 10)) for _ in range(5)]]
+        for dtype in [torch.float32, torch.float64, torch.int64]:
+            for shape in shapes:
+                tensors = [torch.randn(*s).mul(10).to(dtype) for s in shape]
+                nt = ntnt_nograd(tensors)
+                data0 = nt.to_padded_tensor(padding=1)
+                data1, mask1 = nt.to_tensor_mask()
+                data1.masked_fill_(mask1.logical_not(), 1)
+                self.assertEqual(data0, data1)
+
     @unittest.skipIf(not torch.cuda.is_available(), "CUDA not enabled.")
     def test_to_padded_tensor_cuda_dim2(self):
         import random
@@ -865,6 +1028,24 @@ class TestNestedTensor(TestCase):
         _test(torch.float16)
         _test(torch.float32)
 
+    def test_nchw_nhwc_cpu(self):
+        import random
+        random.seed(1010)
+        shapes = [(35,
+                   random.randint(1, 70),
+                   random.randint(1, 70)) for _ in range(9)]
+        for dtype in [torch.float32, torch.float64, torch.int64]:
+            tensors = [torch.randn(*s).mul(10).to(dtype) for s in shapes]
+            nt = ntnt_nograd(tensors)
+            nt0 = nestedtensor.transpose_nchw_nhwc(nt)
+            self.assertEqual(nt0, ntnt_nograd([t.permute(1, 2, 0) for t in tensors]))
+            self.assertEqual(nt, nestedtensor.transpose_nhwc_nchw(nt0))
+            nt_cl = ntnt_nograd(tensors, channels_last=True)
+            self.assertTrue(nt_cl.is_contiguous(memory_format=torch.channels_last))
+            for t_i, nt_i in zip(tensors, nt_cl.unbind()):
+                self.assertEqual(t_i, nt_i)
+            self.assertEqual(nt_cl.contiguous(), nt)
+
 
 class TestContiguous(TestCase):
 
@@ -106,6 +106,29 @@ class TestFunctional(TestCase):
         # self._test_conv2d_dtype(torch.float16, weight, torch.device('cpu'), shapes)
         self._test_conv2d_dtype(torch.float32, weight, torch.device('cpu'), shapes)
 
+    @torch.inference_mode()
+    def test_conv2d_im2col_cpu(self):
+        shapes = [(4, 7, 5), (4, 3, 9), (4, 6, 6)]
+        cpu = torch.device('cpu')
+        for dtype in [torch.float32, torch.float64]:
+            self._test_conv2d_dtype(dtype, torch.randn(6, 4, 3, 3), cpu, shapes,
+                                    stride=[2, 1], padding=[1, 2])
+            self._test_conv2d_dtype(dtype, torch.randn(6, 4, 3, 2), cpu, shapes,
+                                    dilation=[2, 1], padding=[2, 0])
+            self._test_conv2d_dtype(dtype, torch.randn(6, 2, 3, 3), cpu, shapes,
+                                    padding=[1, 1], groups=2)
+        ts = [torch.randn(s) for s in shapes]
+        bias = torch.randn(5)
+        for weight, padding in [(torch.randn(5, 4, 3, 3), 1),
+                                (torch.randn(5, 4, 1, 1), 0)]:
+            nt = ntnt_nograd(ts, channels_last=True)
+            nt_out = torch.conv2d(nt, weight, bias, padding=padding)
+            self.assertTrue(nt_out.is_contiguous(
+                memory_format=torch.channels_last))
+            for t, nt_out_i in zip(ts, nt_out.unbind()):
+                self.assertEqual(torch.conv2d(
+                    t.unsqueeze(0), weight, bias, padding=padding).squeeze(0), nt_out_i)
+
     @torch.inference_mode()
     @unittest.skipIf(not torch.cuda.is_available(), "Test requires cuda")
     def test_conv2d_3x3_resnext_common_cuda(self):
@@ -265,6 +288,55 @@ class TestFunctional(TestCase):
                 2, 2), padding=(1, 1), dilation=(1, 1), ceil_mode=False)
             self.assertEqual(nestedtensor.nested_tensor(tensor_res), nt_res)
 
+    @torch.inference_mode()
+    def test_conv_bn_relu_cpu(self):
+        inputs = [torch.randn(4, 7, 9), torch.randn(4, 5, 5)]
+        conv = torch.nn.Conv2d(4, 6, 3, padding=1).eval()
+        bn = torch.nn.BatchNorm2d(6).eval()
+        bn.running_mean.uniform_(-1, 1)
+        bn.running_var.uniform_(0.5, 2)
+        bn.weight.data.uniform_(-1, 1)
+        bn.bias.data.uniform_(-1, 1)
+        for channels_last in [False, True]:
+            nt = ntnt_nograd(inputs, channels_last=channels_last)
+            for relu in [False, True]:
+                nt_res = nestedtensor.conv_bn_relu(
+                    nt, conv.weight, conv.bias, bn.running_mean, bn.running_var,
+                    bn.weight, bn.bias, bn.eps, padding=1, relu=relu)
+                for t, r in zip(inputs, nt_res.unbind()):
+                    t_res = bn(conv(t.unsqueeze(0))).squeeze(0)
+                    if relu:
+                        t_res = t_res.relu()
+                    self.assertEqual(t_res, r)
+            conv_res = ntnt_nograd([conv(t.unsqueeze(0)).squeeze(0) for t in inputs],
+                                   channels_last=channels_last)
+            bn_res = bn(conv_res)
+            self.assertEqual(bn_res.is_contiguous(memory_format=torch.channels_last),
+                             channels_last)
+            for t, r in zip(conv_res.unbind(), bn_res.unbind()):
+                self.assertEqual(bn(t.unsqueeze(0)).squeeze(0), r)
+
+    @torch.inference_mode()
+    def test_nn_functional_pool2d_cpu(self):
+        inputs = [torch.randn(4, 7, 9), torch.randn(4, 5, 5), torch.randn(4, 12, 3)]
+        inputs[0][1, 2, 3] = float('nan')
+        for channels_last in [False, True]:
+            nt = ntnt_nograd(inputs, channels_last=channels_last)
+            for kwargs in [dict(kernel_size=3, stride=2, padding=1),
+                           dict(kernel_size=(2, 3), stride=(1, 2), dilation=(2, 1)),
+                           dict(kernel_size=2, ceil_mode=True)]:
+                nt_res = torch.nn.functional.max_pool2d(nt, **kwargs)
+                self.assertEqual(nt_res.is_contiguous(memory_format=torch.channels_last),
+                                 channels_last)
+                for t, r in zip(inputs, nt_res.unbind()):
+                    t_res = torch.nn.functional.max_pool2d(t.unsqueeze(0), **kwargs)
+                    self.assertEqual(t_res.squeeze(0), r)
+            for output_size in [(1, 1), (3, 2)]:
+                nt_res = torch.nn.functional.adaptive_avg_pool2d(nt, output_size)
+                for t, r in zip(inputs, nt_res.unbind()):
+                    t_res = torch.nn.functional.adaptive_avg_pool2d(t, output_size)
+                    self.assertEqual(t_res, r)
+
     def test_functional_relu_(self):
         orig_t1 = torch.tensor([-2, -1, 0, 1, 2])
         expected_t = torch.tensor([0, 0, 0, 1, 2])
@@ -415,6 +487,37 @@ class TestFunctional(TestCase):
             self.assertRaises(RuntimeError, lambda: torch.nn.functional.interpolate(
                 nt, size=(100, 100), scale_factor=(1, 1)))
 
+    @torch.inference_mode()
+    def test_nn_functional_interpolate_per_image(self):
+        inputs = [torch.randn(3, 20, 30), torch.randn(3, 30, 17), torch.randn(3, 9, 9)]
+        sizes = [(10, 45), (31, 17), (27, 4)]
+        for mode, align_corners in [('nearest', None), ('bilinear', False), ('bilinear', True)]:
+            nt = ntnt_nograd(inputs)
+            nt_res = torch.nn.functional.interpolate(
+                nt, sizes, mode=mode, align_corners=align_corners)
+            for t, size, r in zip(inputs, sizes, nt_res.unbind()):
+                t_res = torch.nn.functional.interpolate(
+                    t.unsqueeze(0), size, mode=mode, align_corners=align_corners)
+                self.assertEqual(t_res.squeeze(0), r)
+            for scale_factor in [0.5, (1.7, 2.0)]:
+                nt_res = torch.nn.functional.interpolate(
+                    nt, scale_factor=scale_factor, mode=mode,
+                    align_corners=align_corners)
+                for t, r in zip(inputs, nt_res.unbind()):
+                    t_res = torch.nn.functional.interpolate(
+                        t.unsqueeze(0), scale_factor=scale_factor, mode=mode,
+                        align_corners=align_corners)
+                    self.assertEqual(t_res.squeeze(0), r)
+        self.assertRaises(RuntimeError, lambda: torch.nn.functional.interpolate(
+            ntnt_nograd(inputs), sizes, mode='nearest', align_corners=False))
+        self.assertRaises(RuntimeError, lambda: torch.nn.functional.interpolate(
+            ntnt_nograd(inputs), [(10,), (31,), (27,)], mode='bilinear'))
+        nt_res = torch._C._nn.upsample_bilinear2d(
+            ntnt_nograd(inputs), [12, 13], False, None, None)
+        for t, r in zip(inputs, nt_res.unbind()):
+            self.assertEqual(torch.nn.functional.interpolate(
+                t.unsqueeze(0), (12, 13), mode='bilinear').squeeze(0), r)
+
     def test_copy_(self):
         for constructor in _iter_constructors():
             nt1 = constructor([])
@@ -504,6 +607,22 @@ class TestFunctional(TestCase):
             # self.assertEqual(result2[1][0], torch.matmul(t22, t1))
             # self.assertEqual(result2[1][1], torch.matmul(t21, t1))
 
+    @torch.inference_mode()
+    def test_matmul_ragged(self):
+        torch.manual_seed(1010)
+        # Mix of repeated shapes, which are batched, and unique shapes.
+        lengths = [3, 5, 3, 3, 7, 5, 1]
+        a_list = [torch.randn(l, 4) for l in lengths]
+        b_list = [torch.randn(4, l) for l in lengths]
+        result = torch.matmul(ntnt_nograd(a_list), ntnt_nograd(b_list))
+        for a, b, r in zip(a_list, b_list, result.unbind()):
+            self.assertEqual(torch.matmul(a, b), r)
+        a_list = [torch.randn(2, l, 4) for l in lengths]
+        b_list = [torch.randn(2, 4, l) for l in lengths]
+        result = torch.matmul(ntnt_nograd(a_list), ntnt_nograd(b_list))
+        for a, b, r in zip(a_list, b_list, result.unbind()):
+            self.assertEqual(torch.matmul(a, b), r)
+
     @unittest.skip("Currently only supporting nested dim 1.")
     def test_transpose(self):
         t0 = torch.randn(3, 3, 4)
@@ -596,6 +715,34 @@ class TestFunctional(TestCase):
         map(self.assertEqual, zip(ts[0].unbind(), ts_r[0].unbind()))
         map(self.assertEqual, zip(ts[1].unbind(), ts_r[1].unbind()))
 
+    def test_view_shares_buffer(self):
+        ts = [torch.randn(2, 6), torch.randn(3, 6)]
+        buffer = torch.cat([t.reshape(-1) for t in ts])
+        nt = nestedtensor.nested_tensor_from_buffer(
+            buffer, torch.tensor([[2, 6], [3, 6]]))
+        views = [
+            (nt.view(2, -1, 2, 3), [t.view(-1, 2, 3) for t in ts]),
+            (nt.reshape(2, -1, 3, 2), [t.reshape(-1, 3, 2) for t in ts]),
+            (nt.unsqueeze(1), [t.unsqueeze(0) for t in ts]),
+            (nt.unsqueeze(-1), [t.unsqueeze(-1) for t in ts]),
+            (nt.unsqueeze(2).squeeze(2), ts),
+            (nt.view(2, -1, 2, 3).flatten(2, 3), ts),
+            (nt.view(2, -1, 2, 3).flatten(1, 2), [t.view(-1, 3) for t in ts]),
+        ]
+        for view, expected in views:
+            self.assertEqual(view, nestedtensor.nested_tensor(expected))
+        buffer.add_(1)
+        for view, expected in views:
+            self.assertEqual(view, nestedtensor.nested_tensor(
+                [t + 1 for t in expected]))
+        # Views of non-contiguous NestedTensors.
+        transposed = nt.transpose(1, 2)
+        self.assertEqual(transposed.unsqueeze(1).squeeze(1), transposed)
+        self.assertRaises(RuntimeError, lambda: transposed.view(2, -1))
+        self.assertEqual(transposed.reshape(2, -1),
+                         nestedtensor.nested_tensor(
+                             [(t + 1).t().reshape(-1) for t in ts]))
+
     def _test_softmax(self, ts, nt):
         fn = F.softmax
         self.assertRaises(RuntimeError, lambda: fn(nt, 0))
@@ -644,6 +791,28 @@ class TestFunctional(TestCase):
         nt = ntnt_nograd(ts)
         self._test_softmax(ts, nt)
 
+    @torch.inference_mode()
+    def test_softmax_ragged(self):
+        torch.manual_seed(1010)
+        ts = [torch.randn(2, 5, 3), torch.randn(2, 1, 3), torch.randn(2, 4, 3)]
+        nt = ntnt_nograd(ts)
+        for dim in [1, 2, 3, -1]:
+            tdim = dim - 1 if dim > 0 else dim
+            self.assertEqual(
+                ntnt_nograd([torch.softmax(t, tdim) for t in ts]),
+                torch.softmax(nt, dim))
+            self.assertEqual(
+                ntnt_nograd([torch.log_softmax(t, tdim) for t in ts]),
+                torch.log_softmax(nt, dim))
+        masks = [torch.randn(2, 5, 3), torch.randn(2, 1, 3),
+                 torch.randn(2, 4, 3)]
+        result = nestedtensor.masked_softmax(
+            nt, 2, ntnt_nograd(masks), 0.5)
+        self.assertEqual(
+            ntnt_nograd([torch.softmax(0.5 * t + m, 1)
+                         for (t, m) in zip(ts, masks)]),
+            result)
+
     @torch.inference_mode()
     def test_mha(self):
         embed_dim = 2
@@ -666,6 +835,20 @@ class TestFunctional(TestCase):
             query_nt, key_nt, value_nt, need_weights=False)
         self.assertEqual(attn_output.squeeze(1), nt_attn_output[0])
 
+    @torch.inference_mode()
+    def test_mha_self_attention(self):
+        embed_dim = 16
+        num_heads = 4
+        torch.manual_seed(1010)
+        mha = torch.nn.MultiheadAttention(embed_dim, num_heads).eval()
+        inputs = [torch.randn(i, embed_dim) for i in [1, 5, 3, 8]]
+        nt = ntnt_nograd(inputs)
+        result, _ = mha(nt, nt, nt, need_weights=False)
+        for t, r in zip(inputs, result.unbind()):
+            t = t.unsqueeze(1)
+            expected, _ = mha(t, t, t, need_weights=False)
+            self.assertEqual(expected.squeeze(1), r)
+
     @torch.inference_mode()
     def test_mha_detr(self):
         NDIM = 128
@@ -956,6 +1139,66 @@ class TestFunctional(TestCase):
                 _test(torch.device('cuda'), torch.float16, size)
                 _test(torch.device('cuda'), torch.float32, size)
 
+    @torch.inference_mode()
+    def test_add_bias_layer_norm(self):
+        hidden = 16
+        torch.manual_seed(1010)
+        layer_norm = torch.nn.LayerNorm(hidden)
+        bias = torch.randn(hidden)
+        inputs = [torch.randn(i, hidden) for i in [3, 1, 5]]
+        residuals = [torch.randn(i, hidden) for i in [3, 1, 5]]
+        result = nestedtensor.add_bias_layer_norm(
+            ntnt_nograd(inputs), ntnt_nograd(residuals), bias,
+            layer_norm.weight, layer_norm.bias, layer_norm.eps)
+        for t, r, res in zip(inputs, residuals, result.unbind()):
+            self.assertEqual(layer_norm(t + r + bias), res)
+        result = nestedtensor.add_bias_layer_norm(
+            ntnt_nograd(inputs), ntnt_nograd(residuals))
+        for t, r, res in zip(inputs, residuals, result.unbind()):
+            self.assertEqual(
+                torch.nn.functional.layer_norm(t + r, (hidden,)), res)
+
+    @torch.inference_mode()
+    def test_linear_epilogue(self):
+        torch.manual_seed(1010)
+        linear = torch.nn.Linear(8, 16)
+        inputs = [torch.randn(i, 8) for i in [3, 1, 5]]
+        residuals = [torch.randn(i, 16) for i in [3, 1, 5]]
+        activations = {None: lambda x: x,
+                       "relu": torch.nn.functional.relu,
+                       "gelu": torch.nn.functional.gelu,
+                       "silu": torch.nn.functional.silu}
+        for name, fn in activations.items():
+            result = nestedtensor.linear(
+                ntnt_nograd(inputs), linear.weight, linear.bias, name,
+                ntnt_nograd(residuals))
+            for t, r, res in zip(inputs, residuals, result.unbind()):
+                self.assertEqual(fn(linear(t)) + r, res)
+            result = nestedtensor.linear(
+                ntnt_nograd(inputs), linear.weight, activation=name)
+            for t, res in zip(inputs, result.unbind()):
+                self.assertEqual(
+                    fn(torch.nn.functional.linear(t, linear.weight)), res)
+            # A strided selection isn't contiguous and takes the fallback.
+            result = nestedtensor.linear(
+                ntnt_nograd(inputs)[::2], linear.weight, linear.bias, name)
+            for t, res in zip(inputs[::2], result.unbind()):
+                self.assertEqual(fn(linear(t)), res)
+        # A contiguous NestedTensor whose buffer extends past its last
+        # constituent.
+        buffer = torch.randn(9 * 8 + 3)
+        nt = nestedtensor.nested_tensor_from_buffer(
+            buffer, torch.tensor([[3, 8], [1, 8], [5, 8]]),
+            torch.tensor([[8, 1], [8, 1], [8, 1]]))
+        result = nestedtensor.linear(
+            nt, linear.weight, linear.bias, "relu", ntnt_nograd(residuals))
+        for t, r, res in zip(nt.unbind(), residuals, result.unbind()):
+            self.assertEqual(torch.relu(linear(t)) + r, res)
+        self.assertEqual(linear(ntnt_nograd(inputs)),
+                         ntnt_nograd([linear(t) for t in inputs]))
+        self.assertRaises(RuntimeError, lambda: nestedtensor.linear(
+            ntnt_nograd(inputs), linear.weight, activation="tanh"))
+
     @torch.inference_mode()
     def test_decoder(self):
         class TransformerDecoderLayer(nn.Module):
@@ -260,6 +260,53 @@ for func in get_binary_functions():
     setattr(TestBinary, "test_{0}".format(func),
             _gen_test_binary(func, no_grad))
 
+
+class TestBinaryBroadcast(TestCase):
+
+    def test_broadcast_dense(self):
+        torch.manual_seed(1010)
+        tensors = [torch.randn(3, 2, 4), torch.randn(3, 5, 4),
+                   torch.randn(3, 1, 4)]
+        others = [torch.randn(3, 1, 1), torch.randn(4), torch.randn(3, 1, 4),
+                  torch.tensor(2.0)]
+        funcs = [torch.add, torch.sub, torch.mul, torch.div, torch.atan2,
+                 torch.remainder, torch.eq, torch.ne, torch.ge]
+        for other in others:
+            for func in funcs:
+                nt = ntnt_nograd(tensors)
+                expected = [func(t, other) for t in tensors]
+                self.assertEqual(ntnt_nograd(expected), func(nt, other))
+                expected = [func(other, t) for t in tensors]
+                self.assertEqual(ntnt_nograd(expected), func(other, nt))
+            nt = ntnt_nograd([t.abs() + 1 for t in tensors])
+            self.assertEqual(
+                ntnt_nograd([torch.pow(t, other) for t in nt.unbind()]),
+                torch.pow(nt, other))
+            nt = ntnt_nograd(tensors)
+            nt.add_(other, alpha=2)
+            self.assertEqual(
+                ntnt_nograd([t.add(other, alpha=2) for t in tensors]), nt)
+            nt = ntnt_nograd(tensors)
+            nt.mul_(other)
+            self.assertEqual(ntnt_nograd([t * other for t in tensors]), nt)
+
+    def test_broadcast_nested(self):
+        torch.manual_seed(1010)
+        tensors0 = [torch.randn(2, 4), torch.randn(5, 4)]
+        tensors1 = [torch.randn(2, 4), torch.randn(5, 4)]
+        nt0 = ntnt_nograd(tensors0)
+        nt1 = ntnt_nograd(tensors1)
+        for func in [torch.sub, torch.div, torch.ge]:
+            self.assertEqual(
+                ntnt_nograd([func(t0, t1)
+                             for (t0, t1) in zip(tensors0, tensors1)]),
+                func(nt0, nt1))
+        nt0.sub_(nt1)
+        self.assertEqual(
+            ntnt_nograd([t0 - t1 for (t0, t1) in zip(tensors0, tensors1)]),
+            nt0)
+
+
 # TestBinaryMethod = type('TestBinaryMethod', (DynamicClassBase,), {})
 # for func in get_python_binary_arithmetic_operations():
 #     # Not implemented yet
@@ -209,6 +209,33 @@ class TestReduce(TestCase):
         # self.assertEqual(
         #     ntnt([[t0_var1, t1_var1], [t2_var1, t3_var1]]), torch.var(nt, 3))
 
+    def test_segmented_reduce(self):
+        torch.manual_seed(1010)
+        ts = [torch.randn(3, 5, 4), torch.randn(3, 1, 4),
+              torch.randn(3, 7, 4)]
+        nt = ntnt(ts)
+        for dim in [1, 2, 3, -1]:
+            for keepdim in [False, True]:
+                self.assertEqual(
+                    ntnt([t.sum(dim - 1 if dim > 0 else dim, keepdim)
+                          for t in ts]),
+                    nt.sum(dim, keepdim))
+                self.assertEqual(
+                    ntnt([t.mean(dim - 1 if dim > 0 else dim, keepdim)
+                          for t in ts]),
+                    nt.mean(dim, keepdim))
+                self.assertEqual(
+                    ntnt([t.var(dim - 1 if dim > 0 else dim, keepdim=keepdim)
+                          for t in ts]),
+                    nt.var(dim, keepdim=keepdim))
+                values, indices = nt.max(dim, keepdim)
+                for t, v, i in zip(ts, values.unbind(), indices.unbind()):
+                    expected = t.max(dim - 1 if dim > 0 else dim, keepdim)
+                    self.assertEqual(expected[0], v)
+                    self.assertEqual(expected[1], i)
+        self.assertEqual(torch.cat([t.flatten() for t in ts]).sum(), nt.sum())
+        self.assertEqual(torch.cat([t.flatten() for t in ts]).max(), nt.max())
+
     @unittest.skip("Not implemented - needed for autograd.")
     def test_sum_to_size(self):
         a = ntnt([torch.arange(2).reshape(1, 2),
@@ -0,0 +1,56 @@
+import os
+import tempfile
+import torch
+import nestedtensor
+import unittest
+from utils_test_case import TestCase
+
+
+class TestSerialization(TestCase):
+
+    def _roundtrip(self, nt, **kwargs):
+        with tempfile.TemporaryDirectory() as directory:
+            path = os.path.join(directory, "nt.bin")
+            nestedtensor.save(nt, path)
+            return nestedtensor.load(path, **kwargs)
+
+    def test_save_load(self):
+        ts = [torch.randn(3, 4), torch.randn(0, 4), torch.randn(5, 4)]
+        nt = nestedtensor.nested_tensor(ts)
+        for mmap in [True, False]:
+            result = self._roundtrip(nt, mmap=mmap)
+            self.assertEqual(result, nt)
+            self.assertTrue(result.is_contiguous())
+        nt = nestedtensor.nested_tensor(ts, dtype=torch.float16)
+        self.assertEqual(self._roundtrip(nt), nt)
+        nt = nestedtensor.nested_tensor([])
+        self.assertEqual(len(self._roundtrip(nt)), 0)
+
+    def test_save_load_slice(self):
+        ts = [torch.randn(i + 1, 3) for i in range(6)]
+        nt = nestedtensor.nested_tensor(ts)
+        for start, stop in [(0, 6), (2, 5), (None, 3), (4, None), (-2, None)]:
+            result = self._roundtrip(nt, start=start, stop=stop)
+            self.assertEqual(result, nestedtensor.nested_tensor(
+                ts[start:stop]))
+        self.assertEqual(len(self._roundtrip(nt, start=4, stop=2)), 0)
+
+    def test_save_load_channels_last(self):
+        ts = [torch.randn(3, 2, 5), torch.randn(3, 4, 1)]
+        nt = nestedtensor.nested_tensor(ts, channels_last=True)
+        result = self._roundtrip(nt)
+        self.assertTrue(result.is_contiguous(memory_format=torch.channels_last))
+        self.assertEqual(result, nt)
+        result = self._roundtrip(nt, start=1)
+        self.assertEqual(result.unbind()[0], ts[1])
+
+    def test_load_invalid(self):
+        with tempfile.TemporaryDirectory() as directory:
+            path = os.path.join(directory, "nt.bin")
+            with open(path, "wb") as f:
+                f.write(b"not a nested tensor, but long enough")
+            self.assertRaises(RuntimeError, lambda: nestedtensor.load(path))
+
+
+if __name__ == "__main__":
+    unittest.main()